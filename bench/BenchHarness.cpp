@@ -0,0 +1,151 @@
+#include "BenchHarness.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace oc::note::bench {
+
+namespace {
+
+constexpr uint32_t QUICK_DIVISOR = 8;
+
+void writeNumberOrNull(std::ostream& out, bool present, double value) {
+    if (!present) {
+        out << "null";
+        return;
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.4f", value);
+    out << text;
+}
+
+/// Value following `"key":` inside `object`, or -1 when absent or null.
+double findNumber(const std::string& object, const char* key) {
+    const std::string quoted = std::string("\"") + key + "\"";
+    size_t at = object.find(quoted);
+    if (at == std::string::npos) return -1.0;
+    at = object.find(':', at + quoted.size());
+    if (at == std::string::npos) return -1.0;
+
+    const char* begin = object.c_str() + at + 1;
+    char* end = nullptr;
+    const double value = std::strtod(begin, &end);
+    return (end == begin) ? -1.0 : value;
+}
+
+}  // namespace
+
+uint32_t BenchSuite::iterations(uint32_t full) const {
+    if (!options_.quick) return full;
+    const uint32_t scaled = full / QUICK_DIVISOR;
+    return (scaled > 0) ? scaled : 1U;
+}
+
+void BenchSuite::run(const std::string& name, const std::function<BenchCounts()>& body) {
+    if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) return;
+
+    BenchResult result;
+    result.name = name;
+    const uint32_t repetitions = (options_.repetitions > 0) ? options_.repetitions : 1U;
+    for (uint32_t rep = 0; rep < repetitions; ++rep) {
+        const auto begin = std::chrono::steady_clock::now();
+        const BenchCounts counts = body();
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+        if (rep == 0 || ns < result.bestNs) {
+            result.bestNs = ns;
+            result.counts = counts;
+        }
+    }
+
+    char perTick[24] = "-";
+    char perEvent[24] = "-";
+    if (result.counts.ticks > 0) std::snprintf(perTick, sizeof(perTick), "%.2f", result.nsPerTick());
+    if (result.counts.events > 0) std::snprintf(perEvent, sizeof(perEvent), "%.2f", result.nsPerEvent());
+    std::printf("%-64s %12s %12s  %08x\n", name.c_str(), perTick, perEvent, result.counts.checksum);
+    std::fflush(stdout);
+    results_.push_back(std::move(result));
+}
+
+bool writeJson(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    // One result per line keeps baselines diffable and the loader trivial.
+    out << "{\n  \"schema\": 1,\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"ticks\": " << r.counts.ticks
+            << ", \"events\": " << r.counts.events << ", \"ns_per_tick\": ";
+        writeNumberOrNull(out, r.counts.ticks > 0, r.nsPerTick());
+        out << ", \"ns_per_event\": ";
+        writeNumberOrNull(out, r.counts.events > 0, r.nsPerEvent());
+        out << "}" << ((i + 1 < results.size()) ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool loadBaseline(const std::string& path, std::vector<BenchResult>& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t nameKey = line.find("\"name\"");
+        if (nameKey == std::string::npos) continue;
+        const size_t open = line.find('"', line.find(':', nameKey) + 1);
+        const size_t close = line.find('"', open + 1);
+        if (open == std::string::npos || close == std::string::npos) continue;
+
+        // Rebuild a result whose primaryNs() reproduces the stored figure.
+        BenchResult r;
+        r.name = line.substr(open + 1, close - open - 1);
+        const double perTick = findNumber(line, "ns_per_tick");
+        const double perEvent = findNumber(line, "ns_per_event");
+        if (perTick >= 0.0) {
+            r.counts.ticks = 1;
+            r.bestNs = perTick;
+        } else if (perEvent >= 0.0) {
+            r.counts.events = 1;
+            r.bestNs = perEvent;
+        } else {
+            continue;
+        }
+        out.push_back(std::move(r));
+    }
+    return true;
+}
+
+bool compareToBaseline(const std::vector<BenchResult>& current,
+                       const std::vector<BenchResult>& baseline,
+                       double maxRegression) {
+    bool ok = true;
+    std::printf("\n%-64s %12s %12s %9s\n", "benchmark", "baseline ns", "current ns", "delta");
+    for (const BenchResult& now : current) {
+        const BenchResult* before = nullptr;
+        for (const BenchResult& candidate : baseline) {
+            if (candidate.name == now.name) {
+                before = &candidate;
+                break;
+            }
+        }
+        if (before == nullptr || !(before->primaryNs() > 0.0)) {
+            std::printf("%-64s %12s %12.2f %9s\n", now.name.c_str(), "-", now.primaryNs(), "new");
+            continue;
+        }
+
+        const double delta = now.primaryNs() / before->primaryNs() - 1.0;
+        const bool regressed = delta > maxRegression;
+        ok = ok && !regressed;
+        std::printf("%-64s %12.2f %12.2f %+8.1f%%%s\n",
+                    now.name.c_str(), before->primaryNs(), now.primaryNs(), delta * 100.0,
+                    regressed ? "  REGRESSION" : "");
+    }
+    return ok;
+}
+
+}  // namespace oc::note::bench
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace oc::note::bench {
+
+/// What one benchmark body did; ticks or events may be 0 when they do not apply.
+struct BenchCounts {
+    uint64_t ticks = 0;
+    uint64_t events = 0;
+    uint32_t checksum = 0;
+};
+
+struct BenchResult {
+    std::string name;
+    BenchCounts counts;
+    double bestNs = 0.0;
+
+    double nsPerTick() const { return (counts.ticks > 0) ? bestNs / static_cast<double>(counts.ticks) : 0.0; }
+    double nsPerEvent() const { return (counts.events > 0) ? bestNs / static_cast<double>(counts.events) : 0.0; }
+
+    /// Figure compared against a baseline: ns/tick when ticks apply, ns/event otherwise.
+    double primaryNs() const { return (counts.ticks > 0) ? nsPerTick() : nsPerEvent(); }
+};
+
+struct BenchOptions {
+    std::string filter;
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string replayPath;
+    double maxRegression = 0.10;
+    uint32_t repetitions = 5;
+    bool quick = false;
+};
+
+/**
+ * @brief Runs named benchmark bodies and keeps the fastest repetition
+ *
+ * Each body is timed `repetitions` times; the minimum is reported, which is
+ * the most stable figure on a shared host. `quick` scales iteration counts
+ * down for smoke runs.
+ */
+class BenchSuite {
+public:
+    explicit BenchSuite(BenchOptions options)
+        : options_(std::move(options)) {}
+
+    void run(const std::string& name, const std::function<BenchCounts()>& body);
+
+    uint32_t iterations(uint32_t full) const;
+    const BenchOptions& options() const { return options_; }
+    const std::vector<BenchResult>& results() const { return results_; }
+
+private:
+    BenchOptions options_;
+    std::vector<BenchResult> results_;
+};
+
+bool writeJson(const std::string& path, const std::vector<BenchResult>& results);
+bool loadBaseline(const std::string& path, std::vector<BenchResult>& out);
+
+/// Print a per-benchmark delta table; returns false when any result regressed past `maxRegression`.
+bool compareToBaseline(const std::vector<BenchResult>& current,
+                       const std::vector<BenchResult>& baseline,
+                       double maxRegression);
+
+void registerSchedulerBenchmarks(BenchSuite& suite);
+void registerEngineBenchmarks(BenchSuite& suite);
+void registerProbabilityBenchmarks(BenchSuite& suite);
+void registerClockBenchmarks(BenchSuite& suite);
+void registerTraceBenchmarks(BenchSuite& suite);
+void registerBatchBenchmarks(BenchSuite& suite);
+void registerPackedStepBenchmarks(BenchSuite& suite);
+
+}  // namespace oc::note::bench
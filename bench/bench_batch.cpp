@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerBatchRunner.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+#include "BenchHarness.hpp"
+
+using oc::note::sequencer::BatchRenderJob;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::StepSequencerBatchRunner;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace oc::note::bench {
+
+namespace {
+
+/// Per-job sink; padded so neighbouring jobs on different workers do not share a cache line.
+class CountingSink final : public ISequencerEventSink {
+public:
+    alignas(64) uint32_t count = 0;
+    uint32_t checksum = 0;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        ++count;
+        checksum = checksum * 31U + event.tick + event.note;
+        return true;
+    }
+
+    size_t emitSequencerEvents(const SequencerEvent* events, size_t n) override {
+        for (size_t i = 0; i < n; ++i) emitSequencerEvent(events[i]);
+        return n;
+    }
+};
+
+struct Library {
+    std::vector<StepSequencerRuntimeState> patterns;
+    uint32_t ticksPerJob = 0;
+};
+
+std::shared_ptr<Library> makeLibrary(size_t count, uint32_t ticksPerJob) {
+    auto library = std::make_shared<Library>();
+    library->patterns.resize(count);
+    library->ticksPerJob = ticksPerJob;
+    uint32_t rng = 0x2545F491u;
+    for (size_t i = 0; i < count; ++i) {
+        StepSequencerRuntimeState& st = library->patterns[i];
+        st.length = static_cast<uint8_t>(8 + i % 121);
+        for (uint8_t step = 0; step < st.length; ++step) {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            st.enabledMask.setBit(step, (rng & 3U) != 0);
+            st.note[step] = static_cast<uint8_t>(36 + (rng >> 8) % 48U);
+            st.probability[step] = static_cast<uint8_t>(50 + (rng >> 16) % 51U);
+        }
+    }
+    return library;
+}
+
+BenchCounts runBatch(const Library& library, StepSequencerBatchRunner& runner) {
+    const size_t count = library.patterns.size();
+    std::vector<CountingSink> sinks(count);
+    std::vector<BatchRenderJob> jobs(count);
+    for (size_t i = 0; i < count; ++i) {
+        jobs[i].pattern = &library.patterns[i];
+        jobs[i].sink = &sinks[i];
+        jobs[i].tickCount = library.ticksPerJob;
+        jobs[i].runSeed = static_cast<uint32_t>(i + 1);
+    }
+
+    runner.run(jobs.data(), count);
+
+    uint64_t events = 0;
+    uint32_t checksum = 0;
+    for (const CountingSink& sink : sinks) {
+        events += sink.count;
+        checksum = checksum * 31U + sink.checksum;
+    }
+    return {static_cast<uint64_t>(count) * library.ticksPerJob, events, checksum};
+}
+
+}  // namespace
+
+void registerBatchBenchmarks(BenchSuite& suite) {
+    const auto library = makeLibrary(suite.iterations(2000), 24U * 4U * 16U);
+    // A handful of one-bar jobs: dominated by starting and ending the run.
+    const auto shortLibrary = makeLibrary(8, 24U * 4U);
+    const unsigned hardware = std::max(1U, std::thread::hardware_concurrency());
+
+    std::vector<unsigned> workerCounts{1, 2, 4};
+    if (hardware > 4) workerCounts.push_back(hardware);
+    for (const unsigned workers : workerCounts) {
+        // The runner, and its threads, live across repetitions as a host would keep it.
+        const auto runner = std::make_shared<StepSequencerBatchRunner>(workers);
+        suite.run("batch/render/workers=" + std::to_string(workers),
+                  [=] { return runBatch(*library, *runner); });
+        suite.run("batch/short/workers=" + std::to_string(workers),
+                  [=] { return runBatch(*shortLibrary, *runner); });
+    }
+}
+
+}  // namespace oc::note::bench
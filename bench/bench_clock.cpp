@@ -0,0 +1,59 @@
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <oc/note/clock/InternalClock.hpp>
+
+#include "BenchHarness.hpp"
+
+using oc::note::clock::InternalClock;
+
+namespace oc::note::bench {
+
+namespace {
+
+BenchCounts runUpdateMs(float bpm, uint32_t calls) {
+    InternalClock clock;
+    clock.reset();
+    clock.setBpm(bpm);
+    clock.setPlaying(true);
+
+    uint32_t checksum = 0;
+    for (uint32_t ms = 0; ms < calls; ++ms) {
+        clock.update(ms);
+        checksum += clock.tick();
+    }
+    return {clock.tick(), calls, checksum};
+}
+
+/// One call per 128-sample audio block at 48 kHz (2666.67 µs, alternating 2666/2667).
+BenchCounts runUpdateUs(float bpm, uint32_t calls) {
+    InternalClock clock;
+    clock.reset();
+    clock.setBpm(bpm);
+    clock.setPlaying(true);
+
+    uint32_t checksum = 0;
+    uint64_t nowUs = 0;
+    for (uint32_t call = 0; call < calls; ++call) {
+        nowUs += (call % 3U == 2U) ? 2666U : 2667U;
+        clock.updateUs(nowUs);
+        checksum += clock.tick();
+    }
+    return {clock.tick(), calls, checksum};
+}
+
+}  // namespace
+
+void registerClockBenchmarks(BenchSuite& suite) {
+    constexpr std::array<uint16_t, 3> TEMPOS{60, 120, 300};
+    const uint32_t calls = suite.iterations(1000000);
+
+    for (const uint16_t bpm : TEMPOS) {
+        const std::string suffix = "/bpm=" + std::to_string(bpm);
+        suite.run("clock/update_ms" + suffix, [=] { return runUpdateMs(bpm, calls); });
+        suite.run("clock/update_us" + suffix, [=] { return runUpdateUs(bpm, calls); });
+    }
+}
+
+}  // namespace oc::note::bench
@@ -0,0 +1,153 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <oc/note/clock/ClockConstants.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepBitMask128.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+#include "BenchHarness.hpp"
+
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::RenderRangeResult;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace oc::note::bench {
+
+namespace {
+
+enum class ProbabilityMix : uint8_t { Always, Mixed };
+
+struct PatternShape {
+    uint8_t length;
+    uint8_t densityPercent;
+    uint16_t gatePercent;
+    ProbabilityMix probability;
+    uint8_t stepsPerBeat;
+};
+
+class CountingSink final : public ISequencerEventSink {
+public:
+    uint32_t count = 0;
+    uint32_t checksum = 0;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        ++count;
+        checksum = checksum * 31U + event.tick + event.note;
+        return true;
+    }
+};
+
+uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/// Deterministic pattern for `shape`; the same shape always builds the same steps.
+void buildPattern(const PatternShape& shape, StepSequencerRuntimeState& st) {
+    st.reset();
+    st.length = shape.length;
+    st.stepsPerBeat = shape.stepsPerBeat;
+
+    uint32_t rng = 0x9E3779B9u ^ shape.length;
+    StepBitMask128 enabled{};
+    for (uint8_t i = 0; i < shape.length; ++i) {
+        if (nextRandom(rng) % 100U < shape.densityPercent) enabled.setBit(i);
+        st.note[i] = static_cast<uint8_t>(36U + nextRandom(rng) % 48U);
+        st.velocity[i] = static_cast<uint8_t>(40U + nextRandom(rng) % 87U);
+        st.gate[i] = shape.gatePercent;
+        st.nudge[i] = static_cast<int8_t>(static_cast<int32_t>(nextRandom(rng) % 21U) - 10);
+        st.probability[i] = (shape.probability == ProbabilityMix::Always)
+                                ? 100U
+                                : static_cast<uint8_t>(nextRandom(rng) % 101U);
+    }
+    st.enabledMask = enabled;
+}
+
+std::string shapeName(const char* prefix, const PatternShape& shape) {
+    return std::string(prefix) + "/len=" + std::to_string(shape.length)
+           + "/density=" + std::to_string(shape.densityPercent)
+           + "/gate=" + std::to_string(shape.gatePercent)
+           + "/prob=" + ((shape.probability == ProbabilityMix::Always) ? "100" : "mixed")
+           + "/spb=" + std::to_string(shape.stepsPerBeat);
+}
+
+BenchCounts runUpdate(const PatternShape& shape, uint32_t ticks) {
+    StepSequencerRuntimeState state;
+    buildPattern(shape, state);
+    CountingSink sink;
+    StepSequencerEngine engine(state, sink);
+
+    for (uint32_t tick = 0; tick < ticks; ++tick) {
+        engine.update(tick, true);
+    }
+    return {ticks, sink.count, sink.checksum};
+}
+
+BenchCounts runRender(const PatternShape& shape, uint32_t ticks) {
+    constexpr uint32_t BLOCK_TICKS = oc::note::clock::PPQN * 4U;
+
+    StepSequencerRuntimeState state;
+    buildPattern(shape, state);
+    CountingSink sink;
+    StepSequencerEngine engine(state, sink);
+    std::array<SequencerEvent, 256> out{};
+
+    uint64_t events = 0;
+    uint32_t checksum = 0;
+    for (uint32_t from = 0; from < ticks; from += BLOCK_TICKS) {
+        RenderRangeResult result{};
+        do {
+            result = engine.renderRange(from, from + BLOCK_TICKS, out.data(), out.size());
+            for (size_t i = 0; i < result.eventCount; ++i) {
+                checksum = checksum * 31U + out[i].tick + out[i].note;
+            }
+            events += result.eventCount;
+        } while (!result.complete);
+    }
+    return {ticks, events, checksum};
+}
+
+}  // namespace
+
+void registerEngineBenchmarks(BenchSuite& suite) {
+    constexpr std::array<uint8_t, 3> LENGTHS{16, 64, 128};
+    constexpr std::array<uint8_t, 2> DENSITIES{25, 100};
+    constexpr std::array<uint16_t, 2> GATES{50, 180};
+    constexpr std::array<ProbabilityMix, 2> MIXES{ProbabilityMix::Always, ProbabilityMix::Mixed};
+    constexpr std::array<uint8_t, 3> STEPS_PER_BEAT{2, 4, 8};
+    constexpr std::array<uint8_t, 2> RENDER_DENSITIES{100, 3};
+
+    const uint32_t ticks = suite.iterations(oc::note::clock::PPQN * 4U * 200U);
+
+    for (const uint8_t length : LENGTHS) {
+        for (const uint8_t density : DENSITIES) {
+            for (const uint16_t gate : GATES) {
+                for (const ProbabilityMix mix : MIXES) {
+                    for (const uint8_t spb : STEPS_PER_BEAT) {
+                        const PatternShape shape{length, density, gate, mix, spb};
+                        suite.run(shapeName("engine/update", shape), [=] { return runUpdate(shape, ticks); });
+                    }
+                }
+            }
+        }
+    }
+
+    // Dense, then sparse: a block of mostly silent steps should cost about its notes.
+    for (const uint8_t density : RENDER_DENSITIES) {
+        for (const uint8_t length : LENGTHS) {
+            const PatternShape shape{length, density, 100, ProbabilityMix::Mixed, 4};
+            suite.run(shapeName("engine/render", shape), [=] { return runRender(shape, ticks); });
+        }
+    }
+}
+
+}  // namespace oc::note::bench
@@ -0,0 +1,91 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.hpp"
+
+using oc::note::bench::BenchOptions;
+using oc::note::bench::BenchResult;
+using oc::note::bench::BenchSuite;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::printf(
+        "usage: %s [--filter TEXT] [--json PATH] [--baseline PATH]\n"
+        "          [--max-regression FRACTION] [--repetitions N] [--quick]\n"
+        "          [--replay TRACE]\n"
+        "\n"
+        "  --filter          run only benchmarks whose name contains TEXT\n"
+        "  --json            write results as JSON (usable later as a baseline)\n"
+        "  --baseline        compare against a saved JSON; exit 1 on regression\n"
+        "  --max-regression  allowed slowdown before failing (default 0.10)\n"
+        "  --repetitions     timed runs per benchmark, fastest kept (default 5)\n"
+        "  --quick           reduced iteration counts for smoke runs\n"
+        "  --replay          replay a recorded trace file, report divergence and time it\n",
+        program);
+}
+
+bool parseArgs(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(arg, "--quick") == 0) {
+            options.quick = true;
+        } else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (std::strcmp(arg, "--baseline") == 0 && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (std::strcmp(arg, "--replay") == 0 && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (std::strcmp(arg, "--max-regression") == 0 && hasValue) {
+            options.maxRegression = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(arg, "--repetitions") == 0 && hasValue) {
+            options.repetitions = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    BenchSuite suite(options);
+    std::printf("%-64s %12s %12s  %s\n", "benchmark", "ns/tick", "ns/event", "checksum");
+    oc::note::bench::registerSchedulerBenchmarks(suite);
+    oc::note::bench::registerEngineBenchmarks(suite);
+    oc::note::bench::registerProbabilityBenchmarks(suite);
+    oc::note::bench::registerClockBenchmarks(suite);
+    oc::note::bench::registerTraceBenchmarks(suite);
+    oc::note::bench::registerBatchBenchmarks(suite);
+    oc::note::bench::registerPackedStepBenchmarks(suite);
+
+    if (!options.jsonPath.empty() && !oc::note::bench::writeJson(options.jsonPath, suite.results())) {
+        std::fprintf(stderr, "failed to write %s\n", options.jsonPath.c_str());
+        return 2;
+    }
+
+    if (!options.baselinePath.empty()) {
+        std::vector<BenchResult> baseline;
+        if (!oc::note::bench::loadBaseline(options.baselinePath, baseline)) {
+            std::fprintf(stderr, "failed to read %s\n", options.baselinePath.c_str());
+            return 2;
+        }
+        if (!oc::note::bench::compareToBaseline(suite.results(), baseline, options.maxRegression)) {
+            return 1;
+        }
+    }
+    return 0;
+}
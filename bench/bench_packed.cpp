@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <memory>
+
+#include <oc/note/clock/ClockConstants.hpp>
+#include <oc/note/sequencer/MultiTrackSequencerEngine.hpp>
+#include <oc/note/sequencer/MultiTrackSequencerState.hpp>
+#include <oc/note/sequencer/PackedMultiTrackSequencerState.hpp>
+#include <oc/note/sequencer/SequencerConfig.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+
+#include "BenchHarness.hpp"
+
+using oc::note::sequencer::DrumLaneSequencerConfig;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::MultiTrackSequencerEngine;
+using oc::note::sequencer::MultiTrackSequencerState;
+using oc::note::sequencer::PackedMultiTrackSequencerState;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::StepFields;
+
+namespace oc::note::bench {
+
+namespace {
+
+constexpr uint8_t TRACKS = 16;
+using Config = DrumLaneSequencerConfig;
+using Unpacked = MultiTrackSequencerState<TRACKS, Config>;
+using Packed = PackedMultiTrackSequencerState<TRACKS, Config>;
+
+class ChecksumSink final : public ISequencerEventSink {
+public:
+    uint64_t count = 0;
+    uint32_t checksum = 0;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        ++count;
+        checksum = checksum * 31U + event.tick + event.note + event.velocity;
+        return true;
+    }
+};
+
+std::shared_ptr<Unpacked> makeLanes() {
+    auto lanes = std::make_shared<Unpacked>();
+    uint32_t rng = 0x1B873593u;
+    for (uint8_t t = 0; t < TRACKS; ++t) {
+        lanes->length[t] = 16;
+        lanes->midiChannel[t] = 9;
+        for (uint8_t s = 0; s < 16; ++s) {
+            rng = rng * 1664525u + 1013904223u;
+            const size_t slot = Unpacked::stepSlot(t, s);
+            lanes->enabledMask[t].setBit(s, (rng >> 28) < 6U);
+            lanes->note[slot] = static_cast<uint8_t>(36 + t);
+            lanes->velocity[slot] = static_cast<uint8_t>(60 + (rng >> 9) % 60U);
+            lanes->gate[slot] = static_cast<uint16_t>(10 + (rng >> 13) % 90U);
+            lanes->nudge[slot] = static_cast<int8_t>(static_cast<int>((rng >> 17) % 41U) - 20);
+            lanes->probability[slot] = static_cast<uint8_t>(((rng >> 5) & 1U) ? 100 : 50 + (rng >> 21) % 50U);
+        }
+    }
+    return lanes;
+}
+
+/// Read every step's fields `passes` times, the way `scheduleStep_` does.
+template <typename State>
+BenchCounts runDecode(const State& state, uint32_t passes) {
+    uint32_t checksum = 0;
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+        for (size_t slot = 0; slot < State::STEP_SLOTS; ++slot) {
+            const StepFields step = state.stepFields(slot);
+            checksum = checksum * 31U + step.note + step.velocity + step.gate;
+            checksum += static_cast<uint8_t>(step.nudge);
+        }
+    }
+    return {0, static_cast<uint64_t>(passes) * State::STEP_SLOTS, checksum};
+}
+
+template <typename State>
+BenchCounts runEngine(State state, uint32_t ticks) {
+    ChecksumSink sink;
+    MultiTrackSequencerEngine<TRACKS, Config, State> engine(state, sink);
+    for (uint32_t tick = 0; tick < ticks; ++tick) {
+        engine.update(tick, true);
+    }
+    return {ticks, sink.count, sink.checksum};
+}
+
+}  // namespace
+
+void registerPackedStepBenchmarks(BenchSuite& suite) {
+    const auto lanes = makeLanes();
+    const auto packed = std::make_shared<Packed>();
+    packed->packFrom(*lanes);
+
+    const uint32_t passes = suite.iterations(20000);
+    suite.run("packed/decode/unpacked", [=] { return runDecode(*lanes, passes); });
+    suite.run("packed/decode/packed", [=] { return runDecode(*packed, passes); });
+
+    const uint32_t ticks = suite.iterations(oc::note::clock::PPQN * 4U * 500U);
+    suite.run("packed/multitrack16x16/unpacked", [=] { return runEngine(*lanes, ticks); });
+    suite.run("packed/multitrack16x16/packed", [=] { return runEngine(*packed, ticks); });
+}
+
+}  // namespace oc::note::bench
@@ -0,0 +1,96 @@
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <oc/note/sequencer/ProbabilityMaskKernel.hpp>
+#include <oc/note/sequencer/StepBitMask128.hpp>
+
+#include "BenchHarness.hpp"
+
+using oc::note::sequencer::ProbabilityMaskInput;
+using oc::note::sequencer::StepBitMask128;
+
+namespace oc::note::bench {
+
+namespace {
+
+enum class ProbabilityMix : uint8_t { Always, Mixed, Sparse };
+
+struct KernelPattern {
+    std::array<uint8_t, 128> probability{};
+    std::array<uint16_t, 128> gate{};
+    StepBitMask128 enabled{};
+};
+
+const char* mixName(ProbabilityMix mix) {
+    switch (mix) {
+        case ProbabilityMix::Always: return "100";
+        case ProbabilityMix::Mixed: return "mixed";
+        case ProbabilityMix::Sparse: return "sparse";
+    }
+    return "?";
+}
+
+/// Sparse: a quarter of the steps are uncertain, the rest are 0% or 100%.
+KernelPattern buildPattern(ProbabilityMix mix) {
+    KernelPattern p;
+    uint32_t rng = 0xC0FFEEu;
+    for (uint8_t i = 0; i < 128; ++i) {
+        rng = rng * 1664525u + 1013904223u;
+        const uint32_t r = rng >> 8;
+        p.gate[i] = 100;
+        p.enabled.setBit(i);
+        if (mix == ProbabilityMix::Always) {
+            p.probability[i] = 100;
+        } else if (mix == ProbabilityMix::Mixed || (r & 3U) == 0) {
+            p.probability[i] = static_cast<uint8_t>(r % 101U);
+        } else {
+            p.probability[i] = ((r & 4U) != 0) ? 100U : 0U;
+        }
+    }
+    return p;
+}
+
+template <StepBitMask128 (*Resolve)(const ProbabilityMaskInput&)>
+BenchCounts runResolve(const KernelPattern& pattern, uint8_t length, uint32_t cycles) {
+    ProbabilityMaskInput input{};
+    input.probability = pattern.probability.data();
+    input.gate = pattern.gate.data();
+    input.enabledMask = pattern.enabled;
+    input.length = length;
+    input.runSeed = 0x2545F491u;
+
+    uint32_t checksum = 0;
+    for (uint32_t cycle = 0; cycle < cycles; ++cycle) {
+        input.cycleIndex = cycle;
+        const StepBitMask128 mask = Resolve(input);
+        const uint64_t folded = mask.low ^ (mask.high * 0x9E3779B97F4A7C15ull);
+        checksum = checksum * 31U + static_cast<uint32_t>(folded ^ (folded >> 32));
+    }
+    return {0, cycles, checksum};
+}
+
+}  // namespace
+
+void registerProbabilityBenchmarks(BenchSuite& suite) {
+    constexpr std::array<uint8_t, 3> LENGTHS{16, 64, 128};
+    constexpr std::array<ProbabilityMix, 3> MIXES{
+        ProbabilityMix::Always, ProbabilityMix::Mixed, ProbabilityMix::Sparse};
+    const uint32_t cycles = suite.iterations(100000);
+
+    for (const ProbabilityMix mix : MIXES) {
+        const KernelPattern pattern = buildPattern(mix);
+        for (const uint8_t length : LENGTHS) {
+            const std::string suffix =
+                "/len=" + std::to_string(length) + "/prob=" + mixName(mix);
+            suite.run("probability/resolve" + suffix, [=, &pattern] {
+                return runResolve<oc::note::sequencer::resolveProbabilityMask>(pattern, length, cycles);
+            });
+            suite.run("probability/scalar" + suffix, [=, &pattern] {
+                return runResolve<oc::note::sequencer::resolveProbabilityMaskScalar>(pattern, length, cycles);
+            });
+        }
+    }
+}
+
+}  // namespace oc::note::bench
@@ -0,0 +1,158 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <oc/note/sequencer/NoteScheduler.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+
+#include "BenchHarness.hpp"
+
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::NoteScheduler;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+
+namespace oc::note::bench {
+
+namespace {
+
+/// Previous linear-scan scheduler, kept as the comparison baseline.
+class LinearScanNoteScheduler {
+public:
+    static constexpr size_t MAX_EVENTS = 128;
+
+    void clear() { count_ = 0; }
+
+    bool scheduleNoteOn(uint32_t tick, uint8_t channel, uint8_t note, uint8_t velocity) {
+        return schedule_(tick, SequencerEventType::NoteOn, channel, note, velocity);
+    }
+
+    bool scheduleNoteOff(uint32_t tick, uint8_t channel, uint8_t note, uint8_t velocity = 0) {
+        return schedule_(tick, SequencerEventType::NoteOff, channel, note, velocity);
+    }
+
+    bool processUntil(uint32_t tick, ISequencerEventSink& sink) {
+        while (true) {
+            size_t dueIndex = count_;
+            for (size_t i = 0; i < count_; ++i) {
+                if (events_[i].tick > tick) continue;
+                if (dueIndex == count_ || comesBefore_(events_[i], events_[dueIndex])) {
+                    dueIndex = i;
+                }
+            }
+            if (dueIndex == count_) break;
+            if (!sink.emitSequencerEvent(events_[dueIndex])) return false;
+            --count_;
+            if (dueIndex != count_) events_[dueIndex] = events_[count_];
+        }
+        return true;
+    }
+
+private:
+    static bool comesBefore_(const SequencerEvent& lhs, const SequencerEvent& rhs) {
+        if (lhs.tick != rhs.tick) return lhs.tick < rhs.tick;
+        return lhs.type == SequencerEventType::NoteOff && rhs.type != SequencerEventType::NoteOff;
+    }
+
+    bool schedule_(uint32_t tick,
+                   SequencerEventType type,
+                   uint8_t channel,
+                   uint8_t note,
+                   uint8_t velocity) {
+        if (count_ >= MAX_EVENTS) return false;
+        events_[count_++] = {tick, type, channel, note, velocity};
+        return true;
+    }
+
+    std::array<SequencerEvent, MAX_EVENTS> events_{};
+    size_t count_ = 0;
+};
+
+class CountingSink final : public ISequencerEventSink {
+public:
+    uint32_t count = 0;
+    uint32_t checksum = 0;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        ++count;
+        checksum = checksum * 31U + event.tick + event.note;
+        return true;
+    }
+};
+
+uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/// Fill `pending` events across a 4-step window, then drain them all at once.
+template <typename Scheduler>
+BenchCounts drainRounds(size_t pending, uint32_t rounds) {
+    Scheduler scheduler;
+    CountingSink sink;
+    uint32_t rng = 0x12345678u;
+
+    for (uint32_t round = 0; round < rounds; ++round) {
+        const uint32_t base = round * 24U;
+        for (size_t i = 0; i < pending; i += 2) {
+            const uint32_t on = base + (nextRandom(rng) % 24U);
+            const uint8_t note = static_cast<uint8_t>(36U + (i % 48U));
+            scheduler.scheduleNoteOn(on, 0, note, 100);
+            scheduler.scheduleNoteOff(on + 1U + (nextRandom(rng) % 12U), 0, note);
+        }
+        scheduler.processUntil(base + 48U, sink);
+    }
+    return {static_cast<uint64_t>(rounds) * 24U, sink.count, sink.checksum};
+}
+
+/// Queue one `size`-note chord per step and drain it, either as one batch or note by note.
+BenchCounts chordRounds(size_t size, bool batched, uint32_t rounds) {
+    NoteScheduler scheduler;
+    CountingSink sink;
+    std::array<uint8_t, 8> notes{};
+    std::array<uint8_t, 8> velocities{};
+    for (size_t i = 0; i < notes.size(); ++i) {
+        notes[i] = static_cast<uint8_t>(48U + i * 4U);
+        velocities[i] = 100;
+    }
+
+    for (uint32_t round = 0; round < rounds; ++round) {
+        const uint32_t on = round * 6U;
+        if (batched) {
+            scheduler.scheduleChord(on, on + 3U, 0, notes.data(), velocities.data(), size);
+        } else {
+            for (size_t i = 0; i < size; ++i) {
+                scheduler.scheduleNote(on, on + 3U, 0, notes[i], velocities[i]);
+            }
+        }
+        scheduler.processUntil(on + 5U, sink);
+    }
+    return {static_cast<uint64_t>(rounds) * 6U, sink.count, sink.checksum};
+}
+
+}  // namespace
+
+void registerSchedulerBenchmarks(BenchSuite& suite) {
+    constexpr std::array<size_t, 3> PENDING{16, 64, 128};
+    const uint32_t rounds = suite.iterations(20000);
+
+    for (const size_t pending : PENDING) {
+        const std::string suffix = "/pending=" + std::to_string(pending);
+        suite.run("scheduler/linear" + suffix,
+                  [=] { return drainRounds<LinearScanNoteScheduler>(pending, rounds); });
+        suite.run("scheduler/heap" + suffix,
+                  [=] { return drainRounds<NoteScheduler>(pending, rounds); });
+    }
+
+    constexpr std::array<size_t, 2> CHORD_SIZES{3, 6};
+    for (const size_t size : CHORD_SIZES) {
+        const std::string suffix = "/size=" + std::to_string(size);
+        suite.run("scheduler/chord/per-note" + suffix, [=] { return chordRounds(size, false, rounds * 8U); });
+        suite.run("scheduler/chord/batch" + suffix, [=] { return chordRounds(size, true, rounds * 8U); });
+    }
+}
+
+}  // namespace oc::note::bench
@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepBitMask128.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+#include <oc/note/sequencer/StepSequencerTrace.hpp>
+#include <oc/note/sequencer/StepSequencerTraceReplay.hpp>
+
+#include "BenchHarness.hpp"
+
+using oc::note::sequencer::BasicSequencerTrace;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerRuntimeState;
+using oc::note::sequencer::TracedStepSequencerEngine;
+using oc::note::sequencer::TraceRecord;
+using oc::note::sequencer::TraceReplayResult;
+
+namespace oc::note::bench {
+
+namespace {
+
+// Enough for the full (non-quick) workload below: one record per tick plus its events and edits.
+using BenchTrace = BasicSequencerTrace<1U << 16>;
+
+class CountingSink final : public ISequencerEventSink {
+public:
+    uint32_t count = 0;
+    uint32_t checksum = 0;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        ++count;
+        checksum = checksum * 31U + event.tick + event.note;
+        return true;
+    }
+};
+
+void buildPattern(StepSequencerRuntimeState& st) {
+    st.reset();
+    st.length = 16;
+    st.enabledMask = StepBitMask128::prefixMask(16);
+    for (uint8_t i = 0; i < 16; ++i) {
+        st.note[i] = static_cast<uint8_t>(48 + (i * 5) % 24);
+        st.probability[i] = (i % 3 == 0) ? 60 : 100;
+    }
+}
+
+/// One step edit per beat, as a live session would make.
+void editForTick(StepSequencerRuntimeState& st, uint32_t tick) {
+    if (tick % 24U != 0) return;
+    const uint8_t step = static_cast<uint8_t>((tick / 24U) % 16U);
+    st.setNote(step, static_cast<uint8_t>(40 + (tick / 24U) % 40U));
+}
+
+template <typename Engine>
+void drive(Engine& engine, StepSequencerRuntimeState& st, uint32_t ticks) {
+    for (uint32_t tick = 0; tick < ticks; ++tick) {
+        editForTick(st, tick);
+        engine.update(tick, true);
+    }
+}
+
+BenchCounts runPlain(uint32_t ticks) {
+    StepSequencerRuntimeState st;
+    buildPattern(st);
+    CountingSink sink;
+    StepSequencerEngine engine(st, sink);
+    drive(engine, st, ticks);
+    return {ticks, sink.count, sink.checksum};
+}
+
+BenchCounts runRecorded(BenchTrace& trace, uint32_t ticks) {
+    StepSequencerRuntimeState st;
+    buildPattern(st);
+    CountingSink sink;
+    TracedStepSequencerEngine<ISequencerEventSink, BenchTrace> engine(st, sink, trace);
+    drive(engine, st, ticks);
+    return {ticks, sink.count, sink.checksum ^ static_cast<uint32_t>(trace.dropped())};
+}
+
+BenchCounts countsFor(const TraceReplayResult& result) {
+    // Checksum is 0 when the replay reproduced every output, else the first diverging record.
+    const uint32_t checksum = result.matched ? 0U : static_cast<uint32_t>(result.firstMismatch);
+    return {result.updateCount, result.eventCount, checksum};
+}
+
+void registerFileReplay(BenchSuite& suite, const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        std::fprintf(stderr, "trace: cannot open %s\n", path.c_str());
+        return;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[4096];
+    size_t n = 0;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + n);
+    std::fclose(file);
+
+    auto initial = std::make_shared<StepSequencerRuntimeState>();
+    auto records = std::make_shared<std::vector<TraceRecord>>(bytes.size() / sizeof(TraceRecord));
+    size_t count = 0;
+    if (!oc::note::sequencer::readTraceFile(
+            bytes.data(), bytes.size(), *initial, records->data(), records->size(), count)) {
+        std::fprintf(stderr, "trace: %s is not a trace for this build\n", path.c_str());
+        return;
+    }
+
+    const TraceReplayResult check = oc::note::sequencer::replayTrace(*initial, records->data(), count);
+    if (!check.matched) {
+        std::fprintf(stderr, "trace: %s diverges at record %zu\n", path.c_str(), check.firstMismatch);
+    }
+    suite.run("trace/replay/file", [=] {
+        return countsFor(oc::note::sequencer::replayTrace(*initial, records->data(), count));
+    });
+}
+
+}  // namespace
+
+void registerTraceBenchmarks(BenchSuite& suite) {
+    const uint32_t ticks = suite.iterations(24U * 4U * 200U);
+    auto trace = std::make_shared<BenchTrace>();
+
+    suite.run("trace/update/plain", [=] { return runPlain(ticks); });
+    suite.run("trace/update/recorded", [=] { return runRecorded(*trace, ticks); });
+    suite.run("trace/replay/recorded", [=] { return countsFor(oc::note::sequencer::replayTrace(*trace)); });
+
+    if (!suite.options().replayPath.empty()) registerFileReplay(suite, suite.options().replayPath);
+}
+
+}  // namespace oc::note::bench
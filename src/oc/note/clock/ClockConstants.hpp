@@ -7,4 +7,15 @@ namespace oc::note::clock {
 /// MIDI Clock pulses per quarter note
 static constexpr uint16_t PPQN = 24;
 
+/// Finest internal tick resolution the clocks and engines accept.
+static constexpr uint16_t MAX_TICKS_PER_QUARTER = 960;
+
+/// Internal ticks per quarter note rounded down to a multiple of `PPQN`, so one
+/// MIDI Clock pulse is always a whole number of ticks.
+constexpr uint16_t normalizeTicksPerQuarter(uint16_t ticksPerQuarter) {
+    if (ticksPerQuarter < PPQN) return PPQN;
+    if (ticksPerQuarter > MAX_TICKS_PER_QUARTER) return MAX_TICKS_PER_QUARTER;
+    return static_cast<uint16_t>(ticksPerQuarter - ticksPerQuarter % PPQN);
+}
+
 }  // namespace oc::note::clock
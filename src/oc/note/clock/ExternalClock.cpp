@@ -0,0 +1,133 @@
+#include "ExternalClock.hpp"
+
+#include <cmath>
+
+namespace oc::note::clock {
+
+void ExternalClock::reset() {
+    pulse_time_us_ = 0.0;
+    next_pulse_us_ = 0.0;
+    period_us_ = 0.0;
+    last_raw_us_ = 0;
+    has_pulse_ = false;
+    locked_ = false;
+    running_ = false;
+    waiting_for_pulse_ = false;
+    pulse_tick_ = 0;
+    next_pulse_tick_ = 0;
+    tick_ = 0;
+    tick_phase_ = 0.0f;
+    ticks_per_pulse_ = 1;
+    setLoopBandwidth(DEFAULT_LOOP_BANDWIDTH);
+}
+
+void ExternalClock::setLoopBandwidth(float fractionOfPulseRate) {
+    // Critically damped second-order loop: omega = 2*pi*B*T per pulse.
+    double b = static_cast<double>(fractionOfPulseRate);
+    if (!(b > 0.0)) b = static_cast<double>(DEFAULT_LOOP_BANDWIDTH);
+    if (b > 0.25) b = 0.25;
+    const double omega = 2.0 * 3.14159265358979323846 * b;
+    gain_phase_ = std::sqrt(2.0) * omega;
+    gain_period_ = omega * omega;
+}
+
+float ExternalClock::bpm() const {
+    if (!locked_ || !(period_us_ > 0.0)) return 0.0f;
+    return static_cast<float>(60'000'000.0 / (period_us_ * PPQN));
+}
+
+void ExternalClock::trackPulse_(uint64_t nowUs) {
+    const uint64_t interval = nowUs - last_raw_us_;
+    const bool hadPulse = has_pulse_;
+    last_raw_us_ = nowUs;
+    has_pulse_ = true;
+
+    const double now = static_cast<double>(nowUs);
+    if (!hadPulse || interval == 0 || interval > MAX_PULSE_INTERVAL_US) {
+        // First pulse, or the source went quiet: wait for a fresh interval.
+        locked_ = false;
+        pulse_time_us_ = now;
+        next_pulse_us_ = now;
+        return;
+    }
+
+    const double error = now - next_pulse_us_;
+    if (!locked_ || std::fabs(error) > period_us_) {
+        // (Re)lock on the raw interval; the loop cannot pull in a jump this large.
+        locked_ = true;
+        period_us_ = static_cast<double>(interval);
+        pulse_time_us_ = now;
+        next_pulse_us_ = now + period_us_;
+        return;
+    }
+
+    pulse_time_us_ = next_pulse_us_;
+    next_pulse_us_ = pulse_time_us_ + period_us_ + gain_phase_ * error;
+    period_us_ += gain_period_ * error;
+}
+
+void ExternalClock::pulse(uint64_t nowUs) {
+    trackPulse_(nowUs);
+
+    if (waiting_for_pulse_) {
+        waiting_for_pulse_ = false;
+        running_ = true;
+        pulse_tick_ = next_pulse_tick_;
+        tick_ = pulse_tick_;
+        tick_phase_ = 0.0f;
+    } else if (running_) {
+        pulse_tick_ = next_pulse_tick_;
+    } else {
+        return;
+    }
+    next_pulse_tick_ = pulse_tick_ + ticks_per_pulse_;
+    advanceTo_(nowUs);
+}
+
+void ExternalClock::start() {
+    running_ = false;
+    waiting_for_pulse_ = true;
+    next_pulse_tick_ = 0;
+    tick_ = 0;
+    tick_phase_ = 0.0f;
+}
+
+void ExternalClock::stop() {
+    running_ = false;
+    waiting_for_pulse_ = false;
+    tick_phase_ = 0.0f;
+}
+
+void ExternalClock::continuePlayback() {
+    if (running_ || waiting_for_pulse_) return;
+    waiting_for_pulse_ = true;
+    next_pulse_tick_ = (tick_ / ticks_per_pulse_ + 1U) * ticks_per_pulse_;
+}
+
+void ExternalClock::updateUs(uint64_t nowUs) {
+    if (!running_) return;
+    advanceTo_(nowUs);
+}
+
+void ExternalClock::advanceTo_(uint64_t nowUs) {
+    double offset = 0.0;
+    const double span = next_pulse_us_ - pulse_time_us_;
+    if (locked_ && span > 0.0) {
+        offset = (static_cast<double>(nowUs) - pulse_time_us_) / span;
+    }
+    // Hold within one pulse either side of the latest pulse: a late pulse stops
+    // the clock on the tick that pulse stands for.
+    if (offset < -1.0) offset = -1.0;
+    if (offset > 1.0) offset = 1.0;
+
+    const double position = static_cast<double>(pulse_tick_) + offset * ticks_per_pulse_;
+    const double current = static_cast<double>(tick_) + static_cast<double>(tick_phase_);
+    if (!(position > current)) return;
+
+    const double whole = std::floor(position);
+    tick_ = static_cast<uint32_t>(whole);
+    tick_phase_ = static_cast<float>(position - whole);
+    if (tick_phase_ >= 1.0f) tick_phase_ = 0.0f;
+}
+
+}  // namespace oc::note::clock
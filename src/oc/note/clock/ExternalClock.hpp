@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ClockConstants.hpp"
+
+namespace oc::note::clock {
+
+/**
+ * @brief Follower for an external 24-PPQN MIDI clock
+ *
+ * - Feed it timestamped Clock pulses (`pulse`) and the Start/Stop/Continue
+ *   transport messages; call `updateUs` between pulses to move `tick()`.
+ * - A second-order phase-locked loop (delay-locked loop on pulse times)
+ *   smooths the pulse period, so jittery USB/DIN pulses land on an even
+ *   grid instead of going straight into note timing.
+ * - Ticks advance on the smoothed timeline, interpolated between pulses, at
+ *   24 PPQN or the finer resolution set with `setTicksPerQuarter`. `tick()`
+ *   never goes back, never lags the last received pulse by more than one pulse
+ *   and never runs more than one pulse ahead of it.
+ * - Clock pulses keep the loop locked while the transport is stopped. After
+ *   Start, the first pulse is tick 0; after Continue, the first pulse lands on
+ *   the pulse after the one Stop left off at.
+ */
+class ExternalClock {
+public:
+    /// Loop bandwidth as a fraction of the pulse rate.
+    static constexpr float DEFAULT_LOOP_BANDWIDTH = 0.005f;
+    /// Pulses further apart than this (≈ 10 BPM) unlock the loop.
+    static constexpr uint64_t MAX_PULSE_INTERVAL_US = 250'000ULL;
+
+    ExternalClock() { reset(); }
+
+    void reset();
+
+    /// Lower values reject more jitter and follow tempo changes more slowly.
+    void setLoopBandwidth(float fractionOfPulseRate);
+
+    /// Rounded down to a multiple of `PPQN`; set it while stopped.
+    void setTicksPerQuarter(uint16_t ticksPerQuarter) {
+        ticks_per_pulse_ = static_cast<uint16_t>(normalizeTicksPerQuarter(ticksPerQuarter) / PPQN);
+    }
+
+    void pulse(uint64_t nowUs);
+    void start();
+    void stop();
+    void continuePlayback();
+
+    void updateUs(uint64_t nowUs);
+
+    uint32_t tick() const { return tick_; }
+    uint16_t ticksPerQuarter() const { return static_cast<uint16_t>(ticks_per_pulse_ * PPQN); }
+    bool isPlaying() const { return running_; }
+    /// True once two pulses have given the loop a period.
+    bool isLocked() const { return locked_; }
+    /// Smoothed tempo; 0 until locked.
+    float bpm() const;
+
+    /// Fractional position inside the current tick, in [0, 1).
+    float tickPhase() const { return tick_phase_; }
+
+private:
+    void trackPulse_(uint64_t nowUs);
+    void advanceTo_(uint64_t nowUs);
+
+    // Loop state: filtered time of the latest pulse, predicted time of the next
+    // one and the smoothed period, all in µs.
+    double pulse_time_us_ = 0.0;
+    double next_pulse_us_ = 0.0;
+    double period_us_ = 0.0;
+    double gain_phase_ = 0.0;
+    double gain_period_ = 0.0;
+    uint64_t last_raw_us_ = 0;
+    bool has_pulse_ = false;
+    bool locked_ = false;
+
+    // Transport: the tick the latest pulse stands for and the tick the next will.
+    uint16_t ticks_per_pulse_ = 1;
+    bool running_ = false;
+    bool waiting_for_pulse_ = false;
+    uint32_t pulse_tick_ = 0;
+    uint32_t next_pulse_tick_ = 0;
+    uint32_t tick_ = 0;
+    float tick_phase_ = 0.0f;
+};
+
+}  // namespace oc::note::clock
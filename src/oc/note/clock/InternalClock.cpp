@@ -2,56 +2,74 @@
 
 namespace oc::note::clock {
 
-uint32_t InternalClock::tickPeriodUs_() const {
+uint64_t InternalClock::phaseRatePerUs_() const {
     const float bpm = bpm_;
     if (!(bpm > 0.0f)) return 0;
 
-    // period_us = 60s / (BPM * PPQN)
-    const double denom = static_cast<double>(bpm) * static_cast<double>(PPQN);
-    if (!(denom > 0.0)) return 0;
+    // rate = milli-BPM * ticks-per-quarter, so a tick elapses every 60 s * 1000 / rate µs.
+    static constexpr double MAX_MILLI_BPM = 10'000'000.0;
+    double milliBpm = static_cast<double>(bpm) * 1000.0 + 0.5;
+    if (!(milliBpm >= 1.0)) return 0;
+    if (milliBpm > MAX_MILLI_BPM) milliBpm = MAX_MILLI_BPM;
+    return static_cast<uint64_t>(milliBpm) * ticks_per_quarter_;
+}
 
-    const double us = 60'000'000.0 / denom;
-    uint32_t period = static_cast<uint32_t>(us + 0.5);
-    if (period == 0) period = 1;
-    return period;
+void InternalClock::restartTickDomain_() {
+    tick_ = 0;
+    phase_ = 0;
 }
 
-void InternalClock::update(uint32_t nowMs) {
+bool InternalClock::syncTransport_() {
     if (!initialized_) {
         initialized_ = true;
-        last_ms_ = nowMs;
         was_playing_ = playing_;
         if (playing_) {
-            tick_ = 0;
-            accum_us_ = 0;
+            restartTickDomain_();
         }
-        return;
+        return false;
     }
 
     // Detect play start and reset tick domain.
     if (playing_ && !was_playing_) {
-        tick_ = 0;
-        accum_us_ = 0;
-        last_ms_ = nowMs;
+        restartTickDomain_();
         was_playing_ = true;
-        return;
+        return false;
     }
     was_playing_ = playing_;
 
-    const uint32_t deltaMs = nowMs - last_ms_;
-    last_ms_ = nowMs;
+    return playing_;
+}
 
-    if (!playing_) return;
+void InternalClock::advanceUs_(uint64_t deltaUs) {
+    const uint64_t rate = phaseRatePerUs_();
+    if (rate == 0) return;
 
-    const uint32_t periodUs = tickPeriodUs_();
-    if (periodUs == 0) return;
+    // Bound the product; a gap this long is a host stall, not musical time.
+    static constexpr uint64_t MAX_DELTA_US = 1'000'000'000ULL;
+    if (deltaUs > MAX_DELTA_US) deltaUs = MAX_DELTA_US;
 
-    accum_us_ += static_cast<uint64_t>(deltaMs) * 1000ULL;
-    if (accum_us_ < periodUs) return;
+    phase_ += deltaUs * rate;
+    if (phase_ < PHASE_PER_TICK) return;
 
-    const uint64_t inc = accum_us_ / periodUs;
+    const uint64_t inc = phase_ / PHASE_PER_TICK;
     tick_ += static_cast<uint32_t>(inc);
-    accum_us_ -= inc * periodUs;
+    phase_ -= inc * PHASE_PER_TICK;
+}
+
+void InternalClock::update(uint32_t nowMs) {
+    const uint32_t deltaMs = nowMs - last_ms_;
+    last_ms_ = nowMs;
+
+    if (!syncTransport_()) return;
+    advanceUs_(static_cast<uint64_t>(deltaMs) * 1000ULL);
+}
+
+void InternalClock::updateUs(uint64_t nowUs) {
+    const uint64_t deltaUs = nowUs - last_us_;
+    last_us_ = nowUs;
+
+    if (!syncTransport_()) return;
+    advanceUs_(deltaUs);
 }
 
 }  // namespace oc::note::clock
@@ -7,10 +7,16 @@
 namespace oc::note::clock {
 
 /**
- * @brief Internal clock (PPQN=24) for embedded-friendly timing
+ * @brief Internal clock for embedded-friendly timing
  *
- * - Uses ms timestamps (`nowMs`) provided by the host.
+ * - Uses ms (`update`) or µs (`updateUs`) timestamps provided by the host;
+ *   use one of the two per clock instance.
  * - Converts BPM + elapsed time into a monotonic tick counter.
+ * - Carries the sub-tick phase exactly (no per-tick period rounding), so
+ *   `tickPhase()` tells where the host is inside the current tick.
+ * - Ticks at 24 PPQN by default; `setTicksPerQuarter` raises the resolution
+ *   (e.g. 960) for the engine, and `midiClockPulse()` derives the 24-PPQN
+ *   MIDI Clock from it.
  * - Resets tick to 0 on play start.
  */
 class InternalClock {
@@ -18,32 +24,57 @@ public:
     void setPlaying(bool playing) { playing_ = playing; }
     void setBpm(float bpm) { bpm_ = bpm; }
 
+    /// Rounded down to a multiple of `PPQN`; the tick count keeps its value.
+    void setTicksPerQuarter(uint16_t ticksPerQuarter) {
+        ticks_per_quarter_ = normalizeTicksPerQuarter(ticksPerQuarter);
+    }
+
     void reset() {
         playing_ = false;
         was_playing_ = false;
         initialized_ = false;
         bpm_ = 120.0f;
+        ticks_per_quarter_ = PPQN;
         tick_ = 0;
         last_ms_ = 0;
-        accum_us_ = 0;
+        last_us_ = 0;
+        phase_ = 0;
     }
 
     void update(uint32_t nowMs);
+    void updateUs(uint64_t nowUs);
 
     uint32_t tick() const { return tick_; }
+    uint16_t ticksPerQuarter() const { return ticks_per_quarter_; }
+
+    /// MIDI Clock pulses elapsed since play start; send 0xF8 each time it changes.
+    uint32_t midiClockPulse() const { return tick_ / (ticks_per_quarter_ / PPQN); }
     float bpm() const { return bpm_; }
     bool isPlaying() const { return playing_; }
 
+    /// Fractional position inside the current tick, in [0, 1).
+    float tickPhase() const {
+        return static_cast<float>(static_cast<double>(phase_) / static_cast<double>(PHASE_PER_TICK));
+    }
+
 private:
-    uint32_t tickPeriodUs_() const;
+    // Phase is accumulated in µs * milli-BPM * ticks-per-quarter; one tick spans 60 s in BPM units.
+    static constexpr uint64_t PHASE_PER_TICK = 60'000'000ULL * 1000ULL;
+
+    bool syncTransport_();
+    void restartTickDomain_();
+    void advanceUs_(uint64_t deltaUs);
+    uint64_t phaseRatePerUs_() const;
 
     bool playing_ = false;
     bool was_playing_ = false;
     bool initialized_ = false;
     float bpm_ = 120.0f;
+    uint16_t ticks_per_quarter_ = PPQN;
     uint32_t tick_ = 0;
     uint32_t last_ms_ = 0;
-    uint64_t accum_us_ = 0;
+    uint64_t last_us_ = 0;
+    uint64_t phase_ = 0;
 };
 
 }  // namespace oc::note::clock
@@ -0,0 +1,160 @@
+#include "OfflineMidiBounce.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+
+namespace oc::note::midi {
+
+using oc::note::sequencer::BasicStepSequencerEngine;
+using oc::note::sequencer::RenderRangeResult;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+constexpr size_t EVENT_BLOCK_SIZE = 128;
+constexpr uint32_t RENDER_BLOCK_QUARTERS = 4;
+// Longest possible gate (200%) plus a +50% nudge at the slowest step rate, rounded up.
+constexpr uint32_t RELEASE_TAIL_QUARTERS = 3;
+
+/// renderRange never emits through the sink; this only satisfies the engine type.
+struct NullSink {
+    bool emitSequencerEvent(const SequencerEvent&) { return true; }
+    size_t emitSequencerEvents(const SequencerEvent*, size_t count) { return count; }
+};
+
+/// One bit per (channel, note) that has an unmatched NoteOn.
+class SoundingNotes {
+public:
+    void apply(const SequencerEvent& event) {
+        const size_t index = indexOf_(event);
+        const uint32_t bit = 1U << (index % 32U);
+        if (event.type == SequencerEventType::NoteOn && event.velocity > 0) {
+            bits_[index / 32U] |= bit;
+        } else if (event.type == SequencerEventType::NoteOff) {
+            bits_[index / 32U] &= ~bit;
+        }
+    }
+
+    bool isSounding(const SequencerEvent& event) const {
+        const size_t index = indexOf_(event);
+        return (bits_[index / 32U] & (1U << (index % 32U))) != 0;
+    }
+
+    /// Write a NoteOff at `tick` for every sounding note, on its own channel; returns how many.
+    uint32_t releaseAll(uint32_t tick, StandardMidiFileWriter& writer) {
+        uint32_t released = 0;
+        for (size_t word = 0; word < bits_.size(); ++word) {
+            uint32_t bits = bits_[word];
+            while (bits != 0) {
+                const size_t index = word * 32U + static_cast<size_t>(__builtin_ctz(bits));
+                bits &= bits - 1U;
+
+                SequencerEvent off{};
+                off.tick = tick;
+                off.type = SequencerEventType::NoteOff;
+                off.channel = static_cast<uint8_t>(index >> 7);
+                off.note = static_cast<uint8_t>(index & 0x7Fu);
+                writer.writeEvent(off);
+                ++released;
+            }
+        }
+        bits_.fill(0);
+        return released;
+    }
+
+private:
+    static size_t indexOf_(const SequencerEvent& event) {
+        return (static_cast<size_t>(event.channel & 0x0Fu) << 7) | (event.note & 0x7Fu);
+    }
+
+    std::array<uint32_t, 16 * 128 / 32> bits_{};
+};
+
+}  // namespace
+
+MidiBounceResult bounceToMidiFile(const StepSequencerRuntimeState& pattern,
+                                  const MidiBounceOptions& options,
+                                  IMidiFileOutput& output,
+                                  uint8_t* buffer,
+                                  size_t bufferSize) {
+    MidiBounceResult result{};
+    if (options.format > 1 || !(options.bpm > 0.0f)) return result;
+
+    StepSequencerRuntimeState state = pattern;
+    NullSink sink;
+    BasicStepSequencerEngine<NullSink> engine(state, sink);
+    engine.setNextRunSeed(options.runSeed);
+    engine.setTicksPerQuarter(options.ticksPerQuarter);
+    const uint32_t ticksPerQuarter = engine.ticksPerQuarter();
+    const uint32_t renderBlockTicks = RENDER_BLOCK_QUARTERS * ticksPerQuarter;
+
+    StandardMidiFileWriter writer(output, buffer, bufferSize);
+    const double quarter = std::min(60'000'000.0 / static_cast<double>(options.bpm) + 0.5,
+                                    static_cast<double>(StandardMidiFileWriter::MAX_US_PER_QUARTER));
+    const uint32_t usPerQuarter = static_cast<uint32_t>(quarter);
+    const uint32_t totalTicks = options.bars * options.beatsPerBar * ticksPerQuarter;
+
+    const uint16_t trackCount = (options.format == 0) ? 1U : 2U;
+    if (!writer.beginFile(options.format, trackCount, static_cast<uint16_t>(ticksPerQuarter))) return result;
+    if (!writer.beginTrack()) return result;
+    writer.writeTempo(0, usPerQuarter);
+    if (options.format == 1) {
+        writer.endTrack(totalTicks);
+        writer.beginTrack();
+    }
+
+    std::array<SequencerEvent, EVENT_BLOCK_SIZE> events{};
+    SoundingNotes sounding;
+    uint32_t endTick = totalTicks;
+
+    for (uint32_t from = 0; from < totalTicks; from += renderBlockTicks) {
+        const uint32_t to = (totalTicks - from > renderBlockTicks) ? from + renderBlockTicks : totalTicks;
+        RenderRangeResult rendered{};
+        do {
+            rendered = engine.renderRange(from, to, events.data(), events.size());
+            for (size_t i = 0; i < rendered.eventCount; ++i) {
+                // The engine's AllNotesOff carries no channel; release each held note on its own.
+                if (events[i].type == SequencerEventType::AllNotesOff) {
+                    result.eventCount += sounding.releaseAll(events[i].tick, writer);
+                    continue;
+                }
+                sounding.apply(events[i]);
+                writer.writeEvent(events[i]);
+                ++result.eventCount;
+            }
+        } while (!rendered.complete && writer.ok());
+    }
+
+    // Release what is still held at the end; anything starting later is cut.
+    RenderRangeResult tail{};
+    do {
+        tail = engine.renderRange(
+            totalTicks, totalTicks + RELEASE_TAIL_QUARTERS * ticksPerQuarter, events.data(), events.size());
+        for (size_t i = 0; i < tail.eventCount; ++i) {
+            const SequencerEvent& event = events[i];
+            if (event.type == SequencerEventType::AllNotesOff) {
+                const uint32_t released = sounding.releaseAll(event.tick, writer);
+                result.eventCount += released;
+                if (released > 0 && event.tick > endTick) endTick = event.tick;
+                continue;
+            }
+            if (event.type != SequencerEventType::NoteOff || !sounding.isSounding(event)) continue;
+            sounding.apply(event);
+            writer.writeEvent(event);
+            ++result.eventCount;
+            if (event.tick > endTick) endTick = event.tick;
+        }
+    } while (!tail.complete && writer.ok());
+
+    writer.endTrack(endTick);
+    result.ok = writer.flush() && writer.ok();
+    result.bytesWritten = writer.position();
+    result.tickCount = endTick;
+    return result;
+}
+
+}  // namespace oc::note::midi
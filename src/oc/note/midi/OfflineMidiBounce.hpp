@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <oc/note/clock/ClockConstants.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+#include "StandardMidiFileWriter.hpp"
+
+namespace oc::note::midi {
+
+struct MidiBounceOptions {
+    uint32_t bars = 1;
+    uint8_t beatsPerBar = 4;
+    float bpm = 120.0f;
+    uint16_t format = 0;  // SMF type 0 (single track) or 1 (tempo track + note track)
+    uint32_t runSeed = 1;  // probability cycles match a live run started with this seed
+    uint16_t ticksPerQuarter = oc::note::clock::PPQN;  // engine resolution and SMF division
+};
+
+struct MidiBounceResult {
+    bool ok = false;
+    size_t bytesWritten = 0;
+    uint32_t eventCount = 0;
+    uint32_t tickCount = 0;
+};
+
+/**
+ * @brief Render `bars` of a pattern to a Standard MIDI File, faster than realtime
+ *
+ * Drives a private `StepSequencerEngine` over a copy of `pattern` through
+ * `renderRange`, so the caller's state is untouched. Notes still sounding at
+ * the end get their NoteOff; notes starting after the end are dropped.
+ * `buffer` stages output bytes; nothing is heap-allocated.
+ */
+MidiBounceResult bounceToMidiFile(const oc::note::sequencer::StepSequencerRuntimeState& pattern,
+                                  const MidiBounceOptions& options,
+                                  IMidiFileOutput& output,
+                                  uint8_t* buffer,
+                                  size_t bufferSize);
+
+}  // namespace oc::note::midi
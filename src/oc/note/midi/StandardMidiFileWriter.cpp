@@ -0,0 +1,179 @@
+#include "StandardMidiFileWriter.hpp"
+
+#include <cstring>
+
+namespace oc::note::midi {
+
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+
+namespace {
+
+constexpr uint8_t STATUS_NOTE_OFF = 0x80;
+constexpr uint8_t STATUS_NOTE_ON = 0x90;
+constexpr uint8_t STATUS_CONTROL_CHANGE = 0xB0;
+constexpr uint8_t CC_ALL_NOTES_OFF = 123;
+constexpr uint32_t MAX_VARIABLE_LENGTH = 0x0FFFFFFFu;
+
+void storeBigEndian32(uint32_t value, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(value >> 24);
+    out[1] = static_cast<uint8_t>(value >> 16);
+    out[2] = static_cast<uint8_t>(value >> 8);
+    out[3] = static_cast<uint8_t>(value);
+}
+
+}  // namespace
+
+bool MemoryMidiFileOutput::write(const uint8_t* data, size_t size) {
+    if (size > capacity_ - size_) return false;
+    std::memcpy(data_ + size_, data, size);
+    size_ += size;
+    return true;
+}
+
+bool MemoryMidiFileOutput::patch(size_t offset, const uint8_t* data, size_t size) {
+    if (offset > size_ || size > size_ - offset) return false;
+    std::memcpy(data_ + offset, data, size);
+    return true;
+}
+
+size_t StandardMidiFileWriter::encodeVariableLength(uint32_t value, uint8_t* out) {
+    if (value > MAX_VARIABLE_LENGTH) value = MAX_VARIABLE_LENGTH;
+
+    uint8_t groups[4];
+    size_t count = 0;
+    do {
+        groups[count++] = static_cast<uint8_t>(value & 0x7Fu);
+        value >>= 7;
+    } while (value != 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t group = groups[count - 1U - i];
+        out[i] = (i + 1U < count) ? static_cast<uint8_t>(group | 0x80u) : group;
+    }
+    return count;
+}
+
+bool StandardMidiFileWriter::flush() {
+    if (used_ == 0) return ok_;
+    if (ok_ && !output_.write(buffer_, used_)) ok_ = false;
+    flushed_ += used_;
+    used_ = 0;
+    return ok_;
+}
+
+bool StandardMidiFileWriter::put_(const uint8_t* data, size_t size) {
+    if (buffer_ == nullptr || buffer_size_ < MIN_BUFFER_SIZE) {
+        ok_ = false;
+        return false;
+    }
+
+    while (size > 0) {
+        if (used_ == buffer_size_ && !flush()) return false;
+        const size_t chunk = (size < buffer_size_ - used_) ? size : (buffer_size_ - used_);
+        std::memcpy(buffer_ + used_, data, chunk);
+        used_ += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return ok_;
+}
+
+bool StandardMidiFileWriter::putDelta_(uint32_t tick) {
+    const uint32_t delta = (tick > last_tick_) ? (tick - last_tick_) : 0U;
+    if (tick > last_tick_) last_tick_ = tick;
+
+    uint8_t bytes[4];
+    return put_(bytes, encodeVariableLength(delta, bytes));
+}
+
+bool StandardMidiFileWriter::beginFile(uint16_t format, uint16_t trackCount, uint16_t ticksPerQuarter) {
+    const uint8_t header[14] = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6,
+        static_cast<uint8_t>(format >> 8), static_cast<uint8_t>(format),
+        static_cast<uint8_t>(trackCount >> 8), static_cast<uint8_t>(trackCount),
+        static_cast<uint8_t>((ticksPerQuarter >> 8) & 0x7Fu), static_cast<uint8_t>(ticksPerQuarter),
+    };
+    return put_(header, sizeof(header));
+}
+
+bool StandardMidiFileWriter::beginTrack() {
+    if (in_track_) return false;
+
+    const uint8_t header[8] = {'M', 'T', 'r', 'k', 0, 0, 0, 0};
+    track_length_offset_ = position() + 4U;
+    last_tick_ = 0;
+    running_status_ = 0;
+    in_track_ = true;
+    return put_(header, sizeof(header));
+}
+
+bool StandardMidiFileWriter::writeTempo(uint32_t tick, uint32_t usPerQuarter) {
+    if (!in_track_) return false;
+
+    if (usPerQuarter > MAX_US_PER_QUARTER) usPerQuarter = MAX_US_PER_QUARTER;
+    if (usPerQuarter == 0) usPerQuarter = 1;
+
+    const uint8_t meta[6] = {
+        0xFF, 0x51, 0x03,
+        static_cast<uint8_t>(usPerQuarter >> 16),
+        static_cast<uint8_t>(usPerQuarter >> 8),
+        static_cast<uint8_t>(usPerQuarter),
+    };
+    running_status_ = 0;
+    return putDelta_(tick) && put_(meta, sizeof(meta));
+}
+
+bool StandardMidiFileWriter::writeEvent(const SequencerEvent& event) {
+    if (!in_track_) return false;
+
+    const uint8_t channel = event.channel & 0x0Fu;
+    uint8_t message[3];
+    switch (event.type) {
+        case SequencerEventType::NoteOn:
+            message[0] = static_cast<uint8_t>(STATUS_NOTE_ON | channel);
+            message[1] = event.note & 0x7Fu;
+            message[2] = event.velocity & 0x7Fu;
+            break;
+        case SequencerEventType::NoteOff:
+            message[0] = static_cast<uint8_t>(STATUS_NOTE_OFF | channel);
+            message[1] = event.note & 0x7Fu;
+            message[2] = event.velocity & 0x7Fu;
+            break;
+        case SequencerEventType::AllNotesOff:
+            message[0] = static_cast<uint8_t>(STATUS_CONTROL_CHANGE | channel);
+            message[1] = CC_ALL_NOTES_OFF;
+            message[2] = 0;
+            break;
+        case SequencerEventType::ControlChange:
+            message[0] = static_cast<uint8_t>(STATUS_CONTROL_CHANGE | channel);
+            message[1] = event.note & 0x7Fu;
+            message[2] = event.velocity & 0x7Fu;
+            break;
+        default:
+            return ok_;
+    }
+
+    if (!putDelta_(event.tick)) return false;
+    if (message[0] == running_status_) {
+        return put_(message + 1, 2);
+    }
+    running_status_ = message[0];
+    return put_(message, 3);
+}
+
+bool StandardMidiFileWriter::endTrack(uint32_t tick) {
+    if (!in_track_) return false;
+
+    const uint8_t meta[3] = {0xFF, 0x2F, 0x00};
+    if (!putDelta_(tick) || !put_(meta, sizeof(meta)) || !flush()) return false;
+    in_track_ = false;
+
+    const size_t length = position() - (track_length_offset_ + 4U);
+    uint8_t bytes[4];
+    storeBigEndian32(static_cast<uint32_t>(length), bytes);
+    if (!output_.patch(track_length_offset_, bytes, sizeof(bytes))) ok_ = false;
+    return ok_;
+}
+
+}  // namespace oc::note::midi
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <oc/note/sequencer/SequencerEvent.hpp>
+
+namespace oc::note::midi {
+
+/**
+ * @brief Byte destination for a Standard MIDI File
+ *
+ * `patch` rewrites bytes already written (chunk lengths are only known once
+ * a track ends); file-backed outputs seek, memory outputs index.
+ */
+struct IMidiFileOutput {
+    virtual ~IMidiFileOutput() = default;
+    virtual bool write(const uint8_t* data, size_t size) = 0;
+    virtual bool patch(size_t offset, const uint8_t* data, size_t size) = 0;
+};
+
+/// Fixed caller-provided memory region; writes past the end fail.
+class MemoryMidiFileOutput final : public IMidiFileOutput {
+public:
+    MemoryMidiFileOutput(uint8_t* data, size_t capacity)
+        : data_(data)
+        , capacity_(capacity) {}
+
+    bool write(const uint8_t* data, size_t size) override;
+    bool patch(size_t offset, const uint8_t* data, size_t size) override;
+
+    size_t size() const { return size_; }
+    const uint8_t* data() const { return data_; }
+
+private:
+    uint8_t* data_;
+    size_t capacity_;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Streaming SMF (type 0/1) writer over a caller-provided buffer
+ *
+ * Events are given in absolute ticks and encoded as variable-length deltas
+ * with running status. Bytes are staged in `buffer` and flushed to the output
+ * when it fills, so the writer never allocates.
+ */
+class StandardMidiFileWriter {
+public:
+    static constexpr size_t MIN_BUFFER_SIZE = 16;
+    /// Largest tempo the 24-bit Set Tempo meta event holds (about 3.58 bpm).
+    static constexpr uint32_t MAX_US_PER_QUARTER = 0xFFFFFFu;
+
+    StandardMidiFileWriter(IMidiFileOutput& output, uint8_t* buffer, size_t bufferSize)
+        : output_(output)
+        , buffer_(buffer)
+        , buffer_size_(bufferSize) {}
+
+    bool beginFile(uint16_t format, uint16_t trackCount, uint16_t ticksPerQuarter);
+    bool beginTrack();
+    /// Set Tempo meta event; `usPerQuarter` is clamped to [1, MAX_US_PER_QUARTER].
+    bool writeTempo(uint32_t tick, uint32_t usPerQuarter);
+    bool writeEvent(const oc::note::sequencer::SequencerEvent& event);
+    bool endTrack(uint32_t tick);
+    bool flush();
+
+    /// Bytes written so far, including staged bytes.
+    size_t position() const { return flushed_ + used_; }
+    bool ok() const { return ok_; }
+
+    /// Encode `value` (< 2^28) as a MIDI variable-length quantity; returns byte count.
+    static size_t encodeVariableLength(uint32_t value, uint8_t* out);
+
+private:
+    bool put_(const uint8_t* data, size_t size);
+    bool putDelta_(uint32_t tick);
+
+    IMidiFileOutput& output_;
+    uint8_t* buffer_;
+    size_t buffer_size_;
+    size_t used_ = 0;
+    size_t flushed_ = 0;
+    size_t track_length_offset_ = 0;
+    uint32_t last_tick_ = 0;
+    uint8_t running_status_ = 0;
+    bool in_track_ = false;
+    bool ok_ = true;
+};
+
+}  // namespace oc::note::midi
@@ -0,0 +1,7 @@
+#include "CompiledStepPattern.hpp"
+
+namespace oc::note::sequencer {
+
+template class BasicCompiledStepPattern<StepSequencerRuntimeState>;
+
+}  // namespace oc::note::sequencer
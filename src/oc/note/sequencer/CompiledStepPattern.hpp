@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "StepSequencerMath.hpp"
+#include "StepSequencerRuntimeState.hpp"
+
+namespace oc::note::sequencer {
+
+/// One step with its timing already resolved for a given ticks-per-step.
+struct CompiledStep {
+    uint16_t gateTicks = 1;  // NoteOff distance from the nudged NoteOn
+    int16_t onOffset = 0;    // nudge in ticks, within +-ticksPerStep/2
+    uint16_t sourceGate = 0; // gate percent `gateTicks` was derived from
+    uint8_t note = 0;
+    uint8_t velocity = 0;
+    int8_t sourceNudge = 0;  // nudge percent `onOffset` was derived from
+};
+
+static_assert(sizeof(CompiledStep) == 10, "CompiledStep must stay packed");
+
+/**
+ * @brief Per-step timing table for the scheduling hot path
+ *
+ * Holds every step's nudge offset, gate length, note and velocity, plus the
+ * clamped channel, so scheduling a step is a lookup and an add. A change of
+ * ticks-per-step or channel needs a full `compile`; edited steps are patched
+ * with `recompileSteps`. All `State::MAX_STEPS` are compiled, so a length
+ * change needs no rebuild.
+ *
+ * Each entry keeps the fields it was compiled from, so `refreshStep` catches
+ * arrays written directly without the setters when the step is next scheduled.
+ * That check costs four loads and compares per scheduled step on top of the
+ * lookup; edits made through the setters or `markStepDirty` are found through
+ * `generation` instead and need no per-step check to be picked up.
+ */
+template <typename State>
+class BasicCompiledStepPattern {
+public:
+    void invalidate() { valid_ = false; }
+
+    bool isValid() const { return valid_; }
+
+    bool isCurrent(const State& state, uint16_t ticksPerStep) const {
+        return valid_ && ticks_per_step_ == ticksPerStep && source_channel_ == state.midiChannel;
+    }
+
+    void compile(const State& state, uint16_t ticksPerStep) {
+        for (uint8_t i = 0; i < State::MAX_STEPS; ++i) {
+            compileStep_(steps_[i], state, i, ticksPerStep);
+        }
+
+        ticks_per_step_ = ticksPerStep;
+        source_channel_ = state.midiChannel;
+        channel_ = clampMidiChannel(state.midiChannel);
+        valid_ = true;
+    }
+
+    /// Refresh only `steps`; the table must be valid.
+    void recompileSteps(const State& state, const typename State::StepMask& steps) {
+        for (uint8_t index = steps.findNextSet(0); index < State::MAX_STEPS;
+             index = steps.findNextSet(static_cast<uint8_t>(index + 1U))) {
+            compileStep_(steps_[index], state, index, ticks_per_step_);
+        }
+    }
+
+    /// Recompile `index` if its arrays changed since it was compiled; the table must be valid.
+    void refreshStep(const State& state, uint8_t index) {
+        const CompiledStep& step = steps_[index];
+        if (step.note != state.note[index] || step.velocity != state.velocity[index]
+            || step.sourceGate != state.gate[index] || step.sourceNudge != state.nudge[index]) {
+            compileStep_(steps_[index], state, index, ticks_per_step_);
+        }
+    }
+
+    const CompiledStep& step(uint8_t index) const { return steps_[index]; }
+    uint8_t channel() const { return channel_; }
+
+private:
+    static void compileStep_(CompiledStep& step, const State& state, uint8_t index, uint16_t ticksPerStep) {
+        // Gates written straight into the array may exceed the range the chase window covers.
+        const uint16_t gate = State::clampGatePercent(state.gate[index]);
+        step.gateTicks = static_cast<uint16_t>(gateTicks(gate, ticksPerStep));
+        step.onOffset = static_cast<int16_t>(nudgeTickOffset(state.nudge[index], ticksPerStep));
+        step.sourceGate = state.gate[index];
+        step.note = state.note[index];
+        step.velocity = state.velocity[index];
+        step.sourceNudge = state.nudge[index];
+    }
+
+    std::array<CompiledStep, State::MAX_STEPS> steps_{};
+    uint16_t ticks_per_step_ = 0;
+    uint8_t source_channel_ = 0;
+    uint8_t channel_ = 0;
+    bool valid_ = false;
+};
+
+using CompiledStepPattern = BasicCompiledStepPattern<StepSequencerRuntimeState>;
+
+extern template class BasicCompiledStepPattern<StepSequencerRuntimeState>;
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <oc/note/clock/ClockConstants.hpp>
+
+#include "MultiTrackSequencerState.hpp"
+#include "NoteScheduler.hpp"
+#include "PackedMultiTrackSequencerState.hpp"
+#include "ProbabilityMaskKernel.hpp"
+#include "SequencerConfig.hpp"
+#include "SequencerEvent.hpp"
+#include "StepSequencerMath.hpp"
+#include "StepSequencerRuntimeState.hpp"
+
+namespace oc::note::sequencer {
+
+/**
+ * @brief N-track step sequencer driven by one clock
+ *
+ * Same step semantics as `StepSequencerEngine` (gate, nudge, per-cycle
+ * probability), but every track advances in a single pass per step boundary
+ * and all tracks share one scheduler and one event sink. `Config` sizes the
+ * state, the scheduler and the starting tick resolution. `StateType` is the
+ * step storage: `MultiTrackSequencerState` or the packed
+ * `PackedMultiTrackSequencerState`; the engine reads either through
+ * `stepFields` and `probabilityInput`.
+ */
+template <uint8_t TrackCount,
+          typename Config = DefaultSequencerConfig,
+          typename StateType = MultiTrackSequencerState<TrackCount, Config>>
+class MultiTrackSequencerEngine {
+public:
+    using State = StateType;
+    using StepMask = typename State::StepMask;
+
+    // Default 8: two look-ahead steps plus up to two still-sounding NoteOffs, with headroom.
+    static constexpr size_t EVENTS_PER_TRACK = Config::MAX_EVENTS_PER_TRACK;
+    using Scheduler = BasicNoteScheduler<static_cast<size_t>(TrackCount) * EVENTS_PER_TRACK>;
+
+    MultiTrackSequencerEngine(State& state, ISequencerEventSink& eventSink)
+        : state_(state)
+        , event_sink_(eventSink) {
+        for (uint8_t track = 0; track < TrackCount; ++track) {
+            clearCycleMaskCache_(track);
+        }
+    }
+
+    void reset() {
+        stop_();
+        scheduler_.clear();
+        last_tick_ = 0;
+        for (uint8_t track = 0; track < TrackCount; ++track) {
+            next_step_tick_[track] = 0;
+            next_scheduled_step_number_[track] = 0;
+            clearCycleMaskCache_(track);
+            last_enabled_mask_[track] = state_.enabledMask[track];
+        }
+    }
+
+    void update(uint32_t tick, bool playing) {
+        if (playing && !playing_) {
+            start_();
+        } else if (!playing && playing_) {
+            stop_();
+            return;
+        }
+
+        if (!playing_) return;
+
+        // Handle tick resets defensively.
+        if (tick < last_tick_) {
+            scheduler_.clear();
+            for (uint8_t track = 0; track < TrackCount; ++track) {
+                restartTrack_(track);
+            }
+        }
+
+        for (uint8_t track = 0; track < TrackCount; ++track) {
+            if (state_.enabledMask[track] != last_enabled_mask_[track]) {
+                last_enabled_mask_[track] = state_.enabledMask[track];
+                clearCycleMaskCache_(track);
+            }
+        }
+
+        while (true) {
+            uint32_t boundary = UINT32_MAX;
+            for (uint8_t track = 0; track < TrackCount; ++track) {
+                if (state_.patternLength(track) == 0) continue;
+                if (next_step_tick_[track] < boundary) boundary = next_step_tick_[track];
+            }
+            if (boundary > tick) break;
+
+            processDueEvents_(boundary);
+
+            for (uint8_t track = 0; track < TrackCount; ++track) {
+                if (state_.patternLength(track) == 0) continue;
+                if (next_step_tick_[track] != boundary) continue;
+                advanceTrack_(track);
+            }
+        }
+
+        processDueEvents_(tick);
+
+        for (uint8_t track = 0; track < TrackCount; ++track) {
+            if (state_.patternLength(track) == 0) state_.playheadStep[track] = -1;
+        }
+        last_tick_ = tick;
+    }
+
+    bool isPlaying() const { return playing_; }
+
+    /// Tick resolution shared by all tracks; see `BasicStepSequencerEngine::setTicksPerQuarter`.
+    void setTicksPerQuarter(uint16_t ticksPerQuarter) {
+        ticks_per_quarter_ = oc::note::clock::normalizeTicksPerQuarter(ticksPerQuarter);
+    }
+
+    uint16_t ticksPerQuarter() const { return ticks_per_quarter_; }
+
+    size_t pendingEventCount() const { return scheduler_.size(); }
+
+private:
+    static constexpr size_t CYCLE_MASK_CACHE_SIZE = 2;
+
+    uint16_t ticksPerStep_(uint8_t track) const {
+        return ticksPerStep(
+            state_.stepsPerBeat[track], State::Defaults::DEFAULT_STEPS_PER_BEAT, ticks_per_quarter_);
+    }
+
+    uint32_t trackSeed_(uint8_t track) const {
+        return run_seed_ ^ (static_cast<uint32_t>(track) * 0x85EBCA6Bu);
+    }
+
+    void start_() {
+        playing_ = true;
+        scheduler_.clear();
+        last_tick_ = 0;
+        ++run_seed_;
+        for (uint8_t track = 0; track < TrackCount; ++track) {
+            restartTrack_(track);
+        }
+    }
+
+    void stop_() {
+        if (!playing_) return;
+        playing_ = false;
+        scheduler_.clear();
+        emitAllNotesOff_(last_tick_);
+        state_.playheadStep.fill(-1);
+    }
+
+    void restartTrack_(uint8_t track) {
+        next_step_tick_[track] = 0;
+        next_scheduled_step_number_[track] = 0;
+        clearCycleMaskCache_(track);
+        last_enabled_mask_[track] = state_.enabledMask[track];
+
+        if (state_.patternLength(track) == 0) return;
+
+        const uint16_t tps = ticksPerStep_(track);
+        scheduleStep_(track, 0, tps);
+        scheduleStep_(track, 1, tps);
+        next_scheduled_step_number_[track] = 2;
+    }
+
+    void advanceTrack_(uint8_t track) {
+        const uint8_t len = state_.patternLength(track);
+        const uint16_t tps = ticksPerStep_(track);
+        const uint32_t stepNumber = next_step_tick_[track] / tps;
+
+        state_.playheadStep[track] = static_cast<int16_t>(stepNumber % len);
+
+        while (next_scheduled_step_number_[track] < stepNumber + 3U) {
+            scheduleStep_(track, next_scheduled_step_number_[track], tps);
+            ++next_scheduled_step_number_[track];
+        }
+
+        next_step_tick_[track] += tps;
+    }
+
+    void scheduleStep_(uint8_t track, uint32_t stepNumber, uint16_t tps) {
+        const uint8_t len = state_.patternLength(track);
+        if (len == 0) return;
+
+        const uint8_t stepIndex = static_cast<uint8_t>(stepNumber % len);
+        const uint32_t cycleIndex = stepNumber / static_cast<uint32_t>(len);
+        if (!maskForCycle_(track, cycleIndex, len).test(stepIndex)) return;
+
+        const StepFields step = state_.stepFields(State::stepSlot(track, stepIndex));
+        const uint8_t ch = clampMidiChannel(state_.midiChannel[track]);
+
+        const int64_t onTickSigned =
+            static_cast<int64_t>(stepNumber) * tps + nudgeTickOffset(step.nudge, tps);
+        const uint32_t onTick = (onTickSigned < 0) ? 0U : static_cast<uint32_t>(onTickSigned);
+
+        // Clamped as in the mono engine, so one long gate cannot overflow the shared scheduler.
+        const uint16_t gate = StepSequencerRuntimeState::clampGatePercent(step.gate);
+        const uint32_t offTick = onTick + gateTicks(gate, tps);
+        if (scheduler_.scheduleNote(onTick, offTick, ch, step.note, step.velocity)
+            == ScheduleStatus::Rejected) {
+            emitAllNotesOff_(onTick);
+            scheduler_.clear();
+        }
+    }
+
+    StepMask resolveCycleMask_(uint8_t track, uint32_t cycleIndex, uint8_t len) const {
+        ProbabilityMaskInput input{};
+        state_.probabilityInput(track, input);
+        input.length = len;
+        input.runSeed = trackSeed_(track);
+        input.cycleIndex = cycleIndex;
+        return fromStepBitMask128<StepMask>(resolveProbabilityMask(input));
+    }
+
+    StepMask maskForCycle_(uint8_t track, uint32_t cycleIndex, uint8_t len) {
+        auto& indices = cached_cycle_indices_[track];
+        auto& masks = cached_cycle_masks_[track];
+        for (size_t i = 0; i < CYCLE_MASK_CACHE_SIZE; ++i) {
+            if (indices[i] == cycleIndex) return masks[i];
+        }
+
+        const uint8_t slot = next_cycle_cache_slot_[track];
+        indices[slot] = cycleIndex;
+        masks[slot] = resolveCycleMask_(track, cycleIndex, len);
+        next_cycle_cache_slot_[track] = static_cast<uint8_t>((slot + 1U) % CYCLE_MASK_CACHE_SIZE);
+        return masks[slot];
+    }
+
+    void clearCycleMaskCache_(uint8_t track) {
+        cached_cycle_indices_[track].fill(UINT32_MAX);
+        next_cycle_cache_slot_[track] = 0;
+    }
+
+    bool emitAllNotesOff_(uint32_t tick) {
+        SequencerEvent event{};
+        event.tick = tick;
+        event.type = SequencerEventType::AllNotesOff;
+        return event_sink_.emitSequencerEvent(event);
+    }
+
+    bool processDueEvents_(uint32_t tick) {
+        if (scheduler_.processBatchUntil(tick, event_sink_)) {
+            return true;
+        }
+
+        emitAllNotesOff_(tick);
+        scheduler_.clear();
+        return false;
+    }
+
+    State& state_;
+    ISequencerEventSink& event_sink_;
+    Scheduler scheduler_;
+
+    bool playing_ = false;
+    uint16_t ticks_per_quarter_ = Config::TICKS_PER_QUARTER;
+    uint32_t last_tick_ = 0;
+    uint32_t run_seed_ = 0;
+
+    // Per-track runtime, structure-of-arrays like the state.
+    std::array<uint32_t, TrackCount> next_step_tick_{};
+    std::array<uint32_t, TrackCount> next_scheduled_step_number_{};
+    std::array<StepMask, TrackCount> last_enabled_mask_{};
+    std::array<std::array<uint32_t, CYCLE_MASK_CACHE_SIZE>, TrackCount> cached_cycle_indices_{};
+    std::array<std::array<StepMask, CYCLE_MASK_CACHE_SIZE>, TrackCount> cached_cycle_masks_{};
+    std::array<uint8_t, TrackCount> next_cycle_cache_slot_{};
+};
+
+/// Multi-track engine over packed steps.
+template <uint8_t TrackCount, typename Config = DefaultSequencerConfig>
+using PackedMultiTrackSequencerEngine =
+    MultiTrackSequencerEngine<TrackCount, Config, PackedMultiTrackSequencerState<TrackCount, Config>>;
+
+}  // namespace oc::note::sequencer
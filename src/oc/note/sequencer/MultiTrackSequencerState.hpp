@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "PackedStep.hpp"
+#include "ProbabilityMaskKernel.hpp"
+#include "SequencerConfig.hpp"
+#include "StepSequencerRuntimeState.hpp"
+
+namespace oc::note::sequencer {
+
+/**
+ * @brief Engine-side state for N tracks sharing one clock
+ *
+ * Structure-of-arrays layout: every step field is one contiguous array
+ * indexed by `stepSlot(track, step)`, so a per-tick pass over all tracks
+ * touches one cache-friendly block per field instead of N separate states.
+ * `Config::MAX_STEPS` sets the per-track step capacity and mask type.
+ */
+template <uint8_t TrackCount, typename Config = DefaultSequencerConfig>
+struct MultiTrackSequencerState {
+    static_assert(TrackCount > 0, "MultiTrackSequencerState needs at least one track");
+
+    using Defaults = StepSequencerRuntimeState;
+    using StepMask = typename Config::StepMask;
+
+    static constexpr uint8_t TRACK_COUNT = TrackCount;
+    static constexpr uint8_t MAX_STEPS = Config::MAX_STEPS;
+    static constexpr size_t STEP_SLOTS = static_cast<size_t>(TrackCount) * MAX_STEPS;
+
+    // Per-track settings
+    std::array<uint8_t, TrackCount> length{};
+    std::array<uint8_t, TrackCount> stepsPerBeat{};
+    std::array<uint8_t, TrackCount> midiChannel{};
+    std::array<StepMask, TrackCount> enabledMask{};
+    std::array<int16_t, TrackCount> playheadStep{};
+
+    // Per-step fields, track-major
+    std::array<uint8_t, STEP_SLOTS> note{};
+    std::array<uint8_t, STEP_SLOTS> velocity{};
+    std::array<uint16_t, STEP_SLOTS> gate{};
+    std::array<int8_t, STEP_SLOTS> nudge{};
+    std::array<uint8_t, STEP_SLOTS> probability{};
+
+    MultiTrackSequencerState() { reset(); }
+
+    static constexpr size_t stepSlot(uint8_t track, uint8_t step) {
+        return static_cast<size_t>(track) * MAX_STEPS + step;
+    }
+
+    void reset() {
+        length.fill(Defaults::DEFAULT_LENGTH);
+        stepsPerBeat.fill(Defaults::DEFAULT_STEPS_PER_BEAT);
+        midiChannel.fill(Defaults::DEFAULT_MIDI_CHANNEL_0BASED);
+        enabledMask.fill({});
+        playheadStep.fill(-1);
+
+        note.fill(Defaults::DEFAULT_NOTE);
+        velocity.fill(Defaults::DEFAULT_VELOCITY);
+        gate.fill(Defaults::DEFAULT_GATE_PERCENT);
+        nudge.fill(0);
+        probability.fill(Defaults::DEFAULT_PROBABILITY);
+    }
+
+    StepFields stepFields(size_t slot) const { return {note[slot], velocity[slot], gate[slot], nudge[slot]}; }
+
+    void setStepFields(size_t slot, const StepFields& step) {
+        note[slot] = step.note;
+        velocity[slot] = step.velocity;
+        gate[slot] = step.gate;
+        nudge[slot] = step.nudge;
+    }
+
+    /// Point the probability kernel at `track`'s steps.
+    void probabilityInput(uint8_t track, ProbabilityMaskInput& input) const {
+        const size_t base = stepSlot(track, 0);
+        input.probability = probability.data() + base;
+        input.gate = gate.data() + base;
+        input.enabledMask = toStepBitMask128(enabledMask[track]);
+    }
+
+    uint8_t patternLength(uint8_t track) const {
+        const uint8_t len = length[track];
+        return (len > MAX_STEPS) ? MAX_STEPS : len;
+    }
+};
+
+}  // namespace oc::note::sequencer
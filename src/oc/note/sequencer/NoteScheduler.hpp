@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -8,11 +9,56 @@
 
 namespace oc::note::sequencer {
 
-class NoteScheduler {
+/// What `scheduleNote` does when the queue has no room for another NoteOn/NoteOff pair.
+enum class OverflowPolicy : uint8_t {
+    /// Reject; the caller recovers (the engines send AllNotesOff and clear).
+    ClearAll,
+    /// Drop the incoming note; everything already queued plays as scheduled.
+    DropNewest,
+    /// Remove the earliest pending NoteOn to make room; its NoteOff stays queued.
+    StealOldestNoteOn,
+    /// Fold the incoming note into a pending one of the same pitch it overlaps, else drop it.
+    Merge,
+};
+
+enum class ScheduleStatus : uint8_t {
+    Queued,
+    Merged,
+    Stolen,
+    Dropped,
+    Rejected,
+};
+
+/**
+ * @brief Fixed-capacity pending-event queue (binary min-heap)
+ *
+ * Events are released in (tick, NoteOff/ControlChange before NoteOn, insertion
+ * order) order, so a CC set for a step lands before that step's NoteOn.
+ * Insert and pop are O(log n); draining k due events costs O(k log n).
+ *
+ * Entries are 8 bytes: ticks are stored relative to a sliding base (16 bits),
+ * so pending events must span less than 65536 ticks, and the order key is a
+ * single 32-bit compare. Channels are 0..15.
+ *
+ * Notes may carry an 8-bit tag (0 = untagged) so a caller can later withdraw
+ * the ones it queued for a given source with `cancelNotes`. A NoteOff queued
+ * with its NoteOn remembers the low 8 bits of the NoteOn's tick, which pairs
+ * it with its own NoteOn among overlapping notes of the same pitch.
+ */
+template <size_t Capacity, OverflowPolicy Policy = OverflowPolicy::ClearAll>
+class BasicNoteScheduler {
 public:
-    static constexpr size_t MAX_EVENTS = 128;
+    static_assert(Capacity >= 2, "BasicNoteScheduler needs room for a NoteOn/NoteOff pair");
+    static_assert(Capacity <= 0x8000, "BasicNoteScheduler sequence field is 15 bits");
 
-    void clear() { count_ = 0; }
+    static constexpr size_t MAX_EVENTS = Capacity;
+    static constexpr OverflowPolicy OVERFLOW_POLICY = Policy;
+
+    void clear() {
+        count_ = 0;
+        next_sequence_ = 0;
+        base_tick_ = 0;
+    }
 
     size_t size() const { return count_; }
 
@@ -24,31 +70,179 @@ public:
         return schedule_(tick, SequencerEventType::NoteOff, channel, note, velocity);
     }
 
-    bool processUntil(uint32_t tick, ISequencerEventSink& sink) {
-        if (count_ == 0) return true;
+    /**
+     * @brief Queue a CC
+     *
+     * A CC never steals room: when the queue is full it is `Rejected` under
+     * `ClearAll` and `Dropped` under the other policies. A tick outside the
+     * queue's span is `Rejected`, as for notes.
+     */
+    ScheduleStatus scheduleControlChange(uint32_t tick,
+                                         uint8_t channel,
+                                         uint8_t controller,
+                                         uint8_t value,
+                                         uint8_t tag = 0) {
+        if (count_ >= MAX_EVENTS) {
+            return (Policy == OverflowPolicy::ClearAll) ? ScheduleStatus::Rejected : ScheduleStatus::Dropped;
+        }
+        if (!reserveSpan_(tick, tick)) return ScheduleStatus::Rejected;
 
-        while (true) {
-            size_t dueIndex = count_;
+        push_(makeEntry_(tick, SequencerEventType::ControlChange, channel, controller, value, tag));
+        return ScheduleStatus::Queued;
+    }
 
-            for (size_t i = 0; i < count_; ++i) {
-                if (events_[i].tick > tick) continue;
+    /**
+     * @brief Queue a NoteOn and its NoteOff as one unit
+     *
+     * When the pair does not fit, `Policy` decides. Only `Rejected` leaves the
+     * caller with work to do; every other status keeps the queue consistent
+     * (no NoteOn is ever queued without its NoteOff).
+     */
+    ScheduleStatus scheduleNote(uint32_t onTick,
+                                uint32_t offTick,
+                                uint8_t channel,
+                                uint8_t note,
+                                uint8_t velocity,
+                                uint8_t tag = 0) {
+        if (!reserveSpan_(std::min(onTick, offTick), std::max(onTick, offTick))) {
+            return ScheduleStatus::Rejected;
+        }
 
-                if (dueIndex == count_ || comesBefore_(events_[i], events_[dueIndex])) {
-                    dueIndex = i;
-                }
+        ScheduleStatus status = ScheduleStatus::Queued;
+        if (MAX_EVENTS - count_ < 2U) {
+            status = resolveOverflow_(onTick, offTick, channel, note);
+            if (status != ScheduleStatus::Stolen) return status;
+        }
+
+        push_(makeEntry_(onTick, SequencerEventType::NoteOn, channel, note, velocity, tag));
+        push_(makePairedNoteOff_(offTick, onTick, channel, note, tag));
+        return status;
+    }
+
+    /**
+     * @brief Queue `count` notes sharing one span as a single batch
+     *
+     * The span and free room are checked once for the whole chord. When it
+     * does not fit, `ClearAll` rejects it outright; other policies take each
+     * note through `scheduleNote` and report the last status that was not
+     * `Queued`.
+     */
+    ScheduleStatus scheduleChord(uint32_t onTick,
+                                 uint32_t offTick,
+                                 uint8_t channel,
+                                 const uint8_t* notes,
+                                 const uint8_t* velocities,
+                                 size_t count,
+                                 uint8_t tag = 0) {
+        if (!reserveSpan_(std::min(onTick, offTick), std::max(onTick, offTick))) {
+            return ScheduleStatus::Rejected;
+        }
+
+        if (MAX_EVENTS - count_ >= 2U * count) {
+            for (size_t i = 0; i < count; ++i) {
+                push_(makeEntry_(onTick, SequencerEventType::NoteOn, channel, notes[i], velocities[i], tag));
+            }
+            for (size_t i = 0; i < count; ++i) {
+                push_(makePairedNoteOff_(offTick, onTick, channel, notes[i], tag));
             }
+            return ScheduleStatus::Queued;
+        }
 
-            if (dueIndex == count_) {
-                break;
+        if constexpr (Policy == OverflowPolicy::ClearAll) {
+            return ScheduleStatus::Rejected;
+        } else {
+            ScheduleStatus result = ScheduleStatus::Queued;
+            for (size_t i = 0; i < count; ++i) {
+                const ScheduleStatus status =
+                    scheduleNote(onTick, offTick, channel, notes[i], velocities[i], tag);
+                if (status != ScheduleStatus::Queued) result = status;
             }
+            return result;
+        }
+    }
+
+    /**
+     * @brief Withdraw pending notes tagged `tag` whose NoteOn is after `afterTick`
+     *
+     * Each removed NoteOn takes its own NoteOff with it, so a note that already
+     * sounded keeps its release even when it outlasts a cancelled note of the
+     * same pitch. Tagged CCs after `afterTick` go too. Returns the number of
+     * notes removed; costs one pass plus O(n) per NoteOn removed, then one
+     * O(n) re-heapify.
+     */
+    size_t cancelNotes(uint8_t tag, uint32_t afterTick) {
+        if (tag == 0) return 0;
+
+        std::array<bool, MAX_EVENTS> cancelled{};
+        size_t removed = 0;
+        bool any = false;
+        for (size_t i = 0; i < count_; ++i) {
+            const Entry entry = heap_[i];
+            const SequencerEventType type = type_(entry);
+            if (type == SequencerEventType::NoteOff || tag_(entry) != tag || tickOf_(entry) <= afterTick) {
+                continue;
+            }
+
+            cancelled[i] = true;
+            any = true;
+            if (type == SequencerEventType::NoteOn) {
+                const size_t off = findPairedNoteOff_(tag, pitchKey_(entry), tickOf_(entry), cancelled);
+                if (off < count_) cancelled[off] = true;
+                ++removed;
+            }
+        }
+        if (!any) return 0;
+
+        size_t kept = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            if (!cancelled[i]) heap_[kept++] = heap_[i];
+        }
+        count_ = kept;
+        for (size_t i = count_ / 2U; i > 0; --i) {
+            siftDown_(i - 1U);
+        }
+        return removed;
+    }
 
-            if (!sink.emitSequencerEvent(events_[dueIndex])) {
+    /// Emit due events one at a time. `Sink` may be a concrete type to avoid virtual dispatch.
+    template <typename Sink>
+    bool processUntil(uint32_t tick, Sink& sink) {
+        while (count_ > 0 && isDue_(heap_[0], tick)) {
+            // The event stays queued when the sink rejects it.
+            if (!sink.emitSequencerEvent(decode_(heap_[0]))) {
                 return false;
             }
+            popFront_();
+        }
+
+        return true;
+    }
+
+    /// Emit due events as contiguous spans through `Sink::emitSequencerEvents`.
+    template <typename Sink>
+    bool processBatchUntil(uint32_t tick, Sink& sink) {
+        // Nothing due is the common case; skip building the staging arrays.
+        if (count_ == 0 || !isDue_(heap_[0], tick)) return true;
+
+        std::array<SequencerEvent, BATCH_SIZE> events;
+        std::array<Entry, BATCH_SIZE> entries;
 
-            --count_;
-            if (dueIndex != count_) {
-                events_[dueIndex] = events_[count_];
+        while (count_ > 0 && isDue_(heap_[0], tick)) {
+            size_t staged = 0;
+            while (staged < BATCH_SIZE && count_ > 0 && isDue_(heap_[0], tick)) {
+                entries[staged] = heap_[0];
+                events[staged] = decode_(heap_[0]);
+                popFront_();
+                ++staged;
+            }
+
+            const size_t accepted = sink.emitSequencerEvents(events.data(), staged);
+            if (accepted < staged) {
+                // Requeue the rejected tail with its original order keys.
+                for (size_t i = accepted; i < staged; ++i) {
+                    push_(entries[i]);
+                }
+                return false;
             }
         }
 
@@ -56,28 +250,296 @@ public:
     }
 
 private:
-    static bool comesBefore_(const SequencerEvent& lhs, const SequencerEvent& rhs) {
-        if (lhs.tick != rhs.tick) return lhs.tick < rhs.tick;
-        if (lhs.type != rhs.type) return priority_(lhs.type) < priority_(rhs.type);
-        return false;
+    static constexpr size_t BATCH_SIZE = 16;
+
+    static constexpr uint32_t MAX_RELATIVE_TICK = 0xFFFFu;
+    static constexpr uint32_t SEQUENCE_MASK = 0x7FFFu;
+    static constexpr uint32_t LATE_BIT = 0x8000u;
+    static constexpr uint32_t PITCH_MASK = 0x00FF00F0u;
+    static constexpr uint32_t PAIRED_BIT = 0x4u;
+    static constexpr uint32_t ONSET_MASK = 0xFFu;
+    // Room kept below the earliest pending tick so slightly earlier inserts need no rebase.
+    static constexpr uint32_t REBASE_SLACK = 0x100u;
+
+    /**
+     * key:     relTick[31:16] | late[15] (1 = NoteOn) | sequence[14:0]
+     * payload: velocity[31:24] | note[23:16] | tag[15:8] | channel[7:4] | paired[2] | type[1:0]
+     *
+     * A paired NoteOff (queued with its NoteOn) is released with velocity 0 and
+     * holds the low 8 bits of its NoteOn's tick in the velocity byte instead.
+     */
+    // No member initializers: staging arrays of entries stay uninitialized.
+    struct Entry {
+        uint32_t key;
+        uint32_t payload;
+    };
+
+    static_assert(sizeof(Entry) == 8, "Entry must stay 8 bytes");
+
+    static uint32_t relativeTick_(const Entry& entry) { return entry.key >> 16; }
+
+    static bool comesBefore_(const Entry& lhs, const Entry& rhs) { return lhs.key < rhs.key; }
+
+    static SequencerEventType type_(const Entry& entry) {
+        return static_cast<SequencerEventType>(entry.payload & 0x3u);
+    }
+
+    static uint8_t tag_(const Entry& entry) { return static_cast<uint8_t>(entry.payload >> 8); }
+
+    static uint32_t pitchKey_(const Entry& entry) { return entry.payload & PITCH_MASK; }
+
+    static uint32_t pitchKey_(uint8_t channel, uint8_t note) {
+        return (static_cast<uint32_t>(note) << 16) | (static_cast<uint32_t>(channel & 0x0Fu) << 4);
     }
 
-    static uint8_t priority_(SequencerEventType type) {
-        return (type == SequencerEventType::NoteOff) ? 0U : 1U;
+    bool isDue_(const Entry& entry, uint32_t tick) const {
+        if (tick < base_tick_) return false;
+        const uint32_t limit = tick - base_tick_;
+        return limit >= MAX_RELATIVE_TICK || relativeTick_(entry) <= limit;
+    }
+
+    uint32_t tickOf_(const Entry& entry) const { return base_tick_ + relativeTick_(entry); }
+
+    SequencerEvent decode_(const Entry& entry) const {
+        SequencerEvent event{};
+        event.tick = tickOf_(entry);
+        event.type = type_(entry);
+        event.channel = static_cast<uint8_t>((entry.payload >> 4) & 0x0Fu);
+        event.note = static_cast<uint8_t>(entry.payload >> 16);
+        event.velocity = isPaired_(entry) ? 0U : static_cast<uint8_t>(entry.payload >> 24);
+        return event;
+    }
+
+    static bool isPaired_(const Entry& entry) { return (entry.payload & PAIRED_BIT) != 0; }
+
+    /// Whether `off` is a paired NoteOff whose NoteOn is at `onTick`.
+    static bool pairsWith_(const Entry& off, uint32_t onTick) {
+        return isPaired_(off) && (off.payload >> 24) == (onTick & ONSET_MASK);
+    }
+
+    /// Needs a prior successful `reserveSpan_` covering `tick`.
+    Entry makeEntry_(uint32_t tick,
+                     SequencerEventType type,
+                     uint8_t channel,
+                     uint8_t note,
+                     uint8_t velocity,
+                     uint8_t tag = 0) {
+        if (next_sequence_ > SEQUENCE_MASK) renumber_();
+
+        Entry entry;
+        entry.key = ((tick - base_tick_) << 16)
+                    | ((type == SequencerEventType::NoteOn) ? LATE_BIT : 0U)
+                    | next_sequence_++;
+        entry.payload = (static_cast<uint32_t>(velocity) << 24) | pitchKey_(channel, note)
+                        | (static_cast<uint32_t>(tag) << 8) | static_cast<uint32_t>(type);
+        return entry;
+    }
+
+    /// NoteOff for a note starting at `onTick`; needs the same `reserveSpan_` as `makeEntry_`.
+    Entry makePairedNoteOff_(uint32_t offTick, uint32_t onTick, uint8_t channel, uint8_t note, uint8_t tag) {
+        const uint8_t onset = static_cast<uint8_t>(onTick & ONSET_MASK);
+        Entry entry = makeEntry_(offTick, SequencerEventType::NoteOff, channel, note, onset, tag);
+        entry.payload |= PAIRED_BIT;
+        return entry;
+    }
+
+    /// Slide the base so [lo, hi] and every pending tick fit in 16 relative bits.
+    bool reserveSpan_(uint32_t lo, uint32_t hi) {
+        if (count_ > 0) {
+            if (lo >= base_tick_ && hi - base_tick_ <= MAX_RELATIVE_TICK) return true;
+
+            uint32_t maxRelative = 0;
+            for (size_t i = 0; i < count_; ++i) {
+                maxRelative = std::max(maxRelative, relativeTick_(heap_[i]));
+            }
+            lo = std::min(lo, tickOf_(heap_[0]));
+            hi = std::max(hi, base_tick_ + maxRelative);
+        }
+        if (hi - lo > MAX_RELATIVE_TICK) return false;
+
+        const uint32_t base = lo - std::min({lo, REBASE_SLACK, MAX_RELATIVE_TICK - (hi - lo)});
+        // Shifting every key by the same amount keeps the heap order.
+        for (size_t i = 0; i < count_; ++i) {
+            const uint32_t relative = tickOf_(heap_[i]) - base;
+            heap_[i].key = (relative << 16) | (heap_[i].key & 0xFFFFu);
+        }
+        base_tick_ = base;
+        return true;
+    }
+
+    /// Reissue sequences 0..n-1 in release order; a sorted array is a valid heap.
+    void renumber_() {
+        // Insertion sort: the heap is already partly ordered, and unlike std::sort it
+        // gives GCC no unreachable index past small capacities to warn about.
+        for (size_t i = 1; i < count_; ++i) {
+            const Entry entry = heap_[i];
+            size_t at = i;
+            while (at > 0 && comesBefore_(entry, heap_[at - 1U])) {
+                heap_[at] = heap_[at - 1U];
+                --at;
+            }
+            heap_[at] = entry;
+        }
+        for (size_t i = 0; i < count_; ++i) {
+            heap_[i].key = (heap_[i].key & ~SEQUENCE_MASK) | static_cast<uint32_t>(i);
+        }
+        next_sequence_ = static_cast<uint32_t>(count_);
     }
 
     bool schedule_(uint32_t tick,
                    SequencerEventType type,
                    uint8_t channel,
                    uint8_t note,
-                   uint8_t velocity) {
-        if (count_ >= MAX_EVENTS) return false;
-        events_[count_++] = {tick, type, channel, note, velocity};
+                   uint8_t velocity,
+                   uint8_t tag = 0) {
+        if (count_ >= MAX_EVENTS || !reserveSpan_(tick, tick)) return false;
+
+        push_(makeEntry_(tick, type, channel, note, velocity, tag));
         return true;
     }
 
-    std::array<SequencerEvent, MAX_EVENTS> events_{};
+    ScheduleStatus resolveOverflow_(uint32_t onTick, uint32_t offTick, uint8_t channel, uint8_t note) {
+        if constexpr (Policy == OverflowPolicy::ClearAll) {
+            return ScheduleStatus::Rejected;
+        } else if constexpr (Policy == OverflowPolicy::DropNewest) {
+            return ScheduleStatus::Dropped;
+        } else if constexpr (Policy == OverflowPolicy::StealOldestNoteOn) {
+            // Only steal when that actually frees room for the pair.
+            size_t noteOns = 0;
+            for (size_t i = 0; i < count_; ++i) {
+                if (type_(heap_[i]) == SequencerEventType::NoteOn) ++noteOns;
+            }
+            if (MAX_EVENTS - count_ + noteOns < 2U) return ScheduleStatus::Dropped;
+
+            while (MAX_EVENTS - count_ < 2U) {
+                removeAt_(findEarliestNoteOn_());
+            }
+            return ScheduleStatus::Stolen;
+        } else {
+            return mergeInto_(onTick, offTick, channel, note);
+        }
+    }
+
+    /// Earliest pending NoteOn; `count_` when none.
+    size_t findEarliestNoteOn_() const {
+        size_t found = count_;
+        for (size_t i = 0; i < count_; ++i) {
+            if (type_(heap_[i]) != SequencerEventType::NoteOn) continue;
+            if (found == count_ || comesBefore_(heap_[i], heap_[found])) found = i;
+        }
+        return found;
+    }
+
+    /// Earliest NoteOff of `tag` and `pitch` paired with a NoteOn at `onTick` and not yet
+    /// `cancelled`; `count_` if none.
+    size_t findPairedNoteOff_(uint8_t tag,
+                              uint32_t pitch,
+                              uint32_t onTick,
+                              const std::array<bool, MAX_EVENTS>& cancelled) const {
+        size_t found = count_;
+        for (size_t i = 0; i < count_; ++i) {
+            if (cancelled[i]) continue;
+            if (type_(heap_[i]) != SequencerEventType::NoteOff || tag_(heap_[i]) != tag) continue;
+            if (pitchKey_(heap_[i]) != pitch || !pairsWith_(heap_[i], onTick)) continue;
+            if (tickOf_(heap_[i]) < onTick) continue;
+            if (found == count_ || comesBefore_(heap_[i], heap_[found])) found = i;
+        }
+        return found;
+    }
+
+    /// Extend a pending same-pitch note that sounds at `onTick` so it also covers the incoming one.
+    ScheduleStatus mergeInto_(uint32_t onTick, uint32_t offTick, uint8_t channel, uint8_t note) {
+        const uint32_t pitch = pitchKey_(channel, note);
+
+        size_t off = count_;
+        for (size_t i = 0; i < count_; ++i) {
+            if (type_(heap_[i]) != SequencerEventType::NoteOff || pitchKey_(heap_[i]) != pitch) continue;
+            if (tickOf_(heap_[i]) < onTick || startsAfter_(heap_[i], onTick)) continue;
+            if (off == count_ || comesBefore_(heap_[i], heap_[off])) off = i;
+        }
+        if (off == count_) return ScheduleStatus::Dropped;
+
+        if (offTick > tickOf_(heap_[off])) retime_(off, offTick);
+        return ScheduleStatus::Merged;
+    }
+
+    /**
+     * Whether the note `off` releases is still waiting for a NoteOn after `onTick`.
+     * A paired NoteOff matches its own NoteOn by tag and onset byte; an unpaired
+     * one is matched by any same-pitch NoteOn before it.
+     */
+    bool startsAfter_(const Entry& off, uint32_t onTick) const {
+        const uint32_t offTick = tickOf_(off);
+        for (size_t i = 0; i < count_; ++i) {
+            const Entry& on = heap_[i];
+            if (type_(on) != SequencerEventType::NoteOn || pitchKey_(on) != pitchKey_(off)) continue;
+            const uint32_t tick = tickOf_(on);
+            if (tick <= onTick || tick > offTick) continue;
+            if (!isPaired_(off) || (tag_(on) == tag_(off) && pairsWith_(off, tick))) return true;
+        }
+        return false;
+    }
+
+    void retime_(size_t index, uint32_t tick) {
+        Entry entry = heap_[index];
+        removeAt_(index);
+        const uint32_t lateBit = entry.key & LATE_BIT;
+        if (next_sequence_ > SEQUENCE_MASK) renumber_();
+        entry.key = ((tick - base_tick_) << 16) | lateBit | next_sequence_++;
+        push_(entry);
+    }
+
+    void push_(const Entry& entry) {
+        heap_[count_] = entry;
+        siftUp_(count_++);
+    }
+
+    void popFront_() { removeAt_(0); }
+
+    void removeAt_(size_t index) {
+        --count_;
+        if (index == count_) return;
+
+        heap_[index] = heap_[count_];
+        if (index > 0 && comesBefore_(heap_[index], heap_[(index - 1U) / 2U])) {
+            siftUp_(index);
+        } else {
+            siftDown_(index);
+        }
+    }
+
+    void siftUp_(size_t index) {
+        const Entry entry = heap_[index];
+        while (index > 0) {
+            const size_t parent = (index - 1U) / 2U;
+            if (!comesBefore_(entry, heap_[parent])) break;
+            heap_[index] = heap_[parent];
+            index = parent;
+        }
+        heap_[index] = entry;
+    }
+
+    void siftDown_(size_t index) {
+        const Entry entry = heap_[index];
+        while (true) {
+            size_t child = index * 2U + 1U;
+            if (child >= count_) break;
+            if (child + 1U < count_ && comesBefore_(heap_[child + 1U], heap_[child])) {
+                ++child;
+            }
+            if (!comesBefore_(heap_[child], entry)) break;
+            heap_[index] = heap_[child];
+            index = child;
+        }
+        heap_[index] = entry;
+    }
+
+    std::array<Entry, MAX_EVENTS> heap_{};
     size_t count_ = 0;
+    uint32_t next_sequence_ = 0;
+    uint32_t base_tick_ = 0;
 };
 
+using NoteScheduler = BasicNoteScheduler<128>;
+
 }  // namespace oc::note::sequencer
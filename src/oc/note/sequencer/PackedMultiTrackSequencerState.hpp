@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "MultiTrackSequencerState.hpp"
+#include "PackedStep.hpp"
+#include "ProbabilityMaskKernel.hpp"
+#include "SequencerConfig.hpp"
+#include "StepSequencerRuntimeState.hpp"
+
+namespace oc::note::sequencer {
+
+/**
+ * @brief `MultiTrackSequencerState` with each step's fields in one `PackedStep` word
+ *
+ * Five bytes per step (the word plus a probability byte) instead of six, with
+ * the same per-track settings and `stepSlot` indexing, so
+ * `MultiTrackSequencerEngine<N, Config, PackedMultiTrackSequencerState<N, Config>>`
+ * plays it unchanged. Combined with a small `Config::MAX_STEPS` this is the
+ * layout for keeping many tracks or pattern banks in SRAM.
+ *
+ * Converts to and from `MultiTrackSequencerState` and, per track, from and to
+ * `StepSequencerRuntimeState`. Step values are clamped as in `PackedStep::pack`;
+ * the engines clamp the same way, so a converted pattern plays identically.
+ */
+template <uint8_t TrackCount, typename Config = DefaultSequencerConfig>
+struct PackedMultiTrackSequencerState {
+    static_assert(TrackCount > 0, "PackedMultiTrackSequencerState needs at least one track");
+
+    using Defaults = StepSequencerRuntimeState;
+    using StepMask = typename Config::StepMask;
+    using Unpacked = MultiTrackSequencerState<TrackCount, Config>;
+
+    static constexpr uint8_t TRACK_COUNT = TrackCount;
+    static constexpr uint8_t MAX_STEPS = Config::MAX_STEPS;
+    static constexpr size_t STEP_SLOTS = static_cast<size_t>(TrackCount) * MAX_STEPS;
+
+    // Per-track settings
+    std::array<uint8_t, TrackCount> length{};
+    std::array<uint8_t, TrackCount> stepsPerBeat{};
+    std::array<uint8_t, TrackCount> midiChannel{};
+    std::array<StepMask, TrackCount> enabledMask{};
+    std::array<int16_t, TrackCount> playheadStep{};
+
+    // Per-step fields, track-major
+    std::array<uint32_t, STEP_SLOTS> step{};
+    std::array<uint8_t, STEP_SLOTS> probability{};
+
+    PackedMultiTrackSequencerState() { reset(); }
+
+    static constexpr size_t stepSlot(uint8_t track, uint8_t stepIndex) {
+        return static_cast<size_t>(track) * MAX_STEPS + stepIndex;
+    }
+
+    void reset() {
+        length.fill(Defaults::DEFAULT_LENGTH);
+        stepsPerBeat.fill(Defaults::DEFAULT_STEPS_PER_BEAT);
+        midiChannel.fill(Defaults::DEFAULT_MIDI_CHANNEL_0BASED);
+        enabledMask.fill({});
+        playheadStep.fill(-1);
+
+        step.fill(PackedStep::pack(
+            {Defaults::DEFAULT_NOTE, Defaults::DEFAULT_VELOCITY, Defaults::DEFAULT_GATE_PERCENT, 0}));
+        probability.fill(Defaults::DEFAULT_PROBABILITY);
+    }
+
+    StepFields stepFields(size_t slot) const { return PackedStep::unpack(step[slot]); }
+
+    void setStepFields(size_t slot, const StepFields& fields) { step[slot] = PackedStep::pack(fields); }
+
+    /// Point the probability kernel at `track`'s steps; zero-gate steps are folded out of the mask.
+    void probabilityInput(uint8_t track, ProbabilityMaskInput& input) const {
+        const size_t base = stepSlot(track, 0);
+        StepMask gated{};
+        for (uint8_t i = 0; i < MAX_STEPS; ++i) {
+            if (PackedStep::gate(step[base + i]) != 0) gated.setBit(i);
+        }
+        input.probability = probability.data() + base;
+        input.gate = nullptr;
+        input.enabledMask = toStepBitMask128(enabledMask[track] & gated);
+    }
+
+    uint8_t patternLength(uint8_t track) const {
+        const uint8_t len = length[track];
+        return (len > MAX_STEPS) ? MAX_STEPS : len;
+    }
+
+    void packFrom(const Unpacked& source) {
+        length = source.length;
+        stepsPerBeat = source.stepsPerBeat;
+        midiChannel = source.midiChannel;
+        enabledMask = source.enabledMask;
+        playheadStep = source.playheadStep;
+        for (size_t slot = 0; slot < STEP_SLOTS; ++slot) {
+            setStepFields(slot, source.stepFields(slot));
+            probability[slot] = Defaults::clampProbability(source.probability[slot]);
+        }
+    }
+
+    void unpackTo(Unpacked& target) const {
+        target.length = length;
+        target.stepsPerBeat = stepsPerBeat;
+        target.midiChannel = midiChannel;
+        target.enabledMask = enabledMask;
+        target.playheadStep = playheadStep;
+        for (size_t slot = 0; slot < STEP_SLOTS; ++slot) {
+            target.setStepFields(slot, stepFields(slot));
+            target.probability[slot] = probability[slot];
+        }
+    }
+
+    /// Copy the first `MAX_STEPS` steps of a single-track pattern; chords and locks are not carried.
+    void packTrack(uint8_t track, const StepSequencerRuntimeState& source) {
+        length[track] = source.length;
+        stepsPerBeat[track] = source.stepsPerBeat;
+        midiChannel[track] = source.midiChannel;
+        enabledMask[track] = fromStepBitMask128<StepMask>(source.enabledMask);
+        for (uint8_t i = 0; i < MAX_STEPS; ++i) {
+            const size_t slot = stepSlot(track, i);
+            setStepFields(slot, {source.note[i], source.velocity[i], source.gate[i], source.nudge[i]});
+            probability[slot] = Defaults::clampProbability(source.probability[i]);
+        }
+    }
+
+    /// Write `track` into a single-track pattern; its steps past `MAX_STEPS` end up disabled.
+    void unpackTrack(uint8_t track, StepSequencerRuntimeState& target) const {
+        target.length = length[track];
+        target.stepsPerBeat = stepsPerBeat[track];
+        target.midiChannel = midiChannel[track];
+        target.enabledMask = toStepBitMask128(enabledMask[track]);
+        for (uint8_t i = 0; i < MAX_STEPS; ++i) {
+            const size_t slot = stepSlot(track, i);
+            const StepFields fields = stepFields(slot);
+            target.note[i] = fields.note;
+            target.velocity[i] = fields.velocity;
+            target.gate[i] = fields.gate;
+            target.nudge[i] = fields.nudge;
+            target.probability[i] = probability[slot];
+        }
+        target.markStepDataChanged();
+    }
+};
+
+}  // namespace oc::note::sequencer
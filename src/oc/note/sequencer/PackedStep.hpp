@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+#include "StepSequencerRuntimeState.hpp"
+
+namespace oc::note::sequencer {
+
+/// One step's note and timing fields, as the engines read them.
+struct StepFields {
+    uint8_t note = 0;
+    uint8_t velocity = 0;
+    uint16_t gate = 0;
+    int8_t nudge = 0;
+};
+
+/**
+ * @brief Step fields packed in one 32-bit word
+ *
+ * | bits  | field                      |
+ * |-------|----------------------------|
+ * | 0-6   | note (0..127)              |
+ * | 7-13  | velocity (0..127)          |
+ * | 14-21 | gate percent (0..200)      |
+ * | 22-28 | nudge + 50 (0..100)        |
+ * | 29-31 | zero                       |
+ *
+ * `pack` clamps to these ranges, which are the ones the engines honour
+ * (nudge is clamped to +-50 and MIDI data is 7-bit), so a packed step plays
+ * exactly like the step it came from. Probability is not in the word: the
+ * probability kernel loads it as 16 contiguous bytes.
+ */
+struct PackedStep {
+    static constexpr uint32_t NOTE_SHIFT = 0;
+    static constexpr uint32_t VELOCITY_SHIFT = 7;
+    static constexpr uint32_t GATE_SHIFT = 14;
+    static constexpr uint32_t NUDGE_SHIFT = 22;
+    static constexpr uint32_t SEVEN_BITS = 0x7Fu;
+    static constexpr uint32_t EIGHT_BITS = 0xFFu;
+    static constexpr int8_t NUDGE_LIMIT = 50;
+
+    static constexpr uint32_t pack(const StepFields& step) {
+        const uint8_t note = (step.note > 127U) ? 127U : step.note;
+        const uint8_t velocity = (step.velocity > 127U) ? 127U : step.velocity;
+        const uint16_t gate = (step.gate > StepSequencerRuntimeState::MAX_GATE_PERCENT)
+                                  ? StepSequencerRuntimeState::MAX_GATE_PERCENT
+                                  : step.gate;
+        const int8_t nudge = (step.nudge < -NUDGE_LIMIT) ? static_cast<int8_t>(-NUDGE_LIMIT)
+                             : (step.nudge > NUDGE_LIMIT) ? NUDGE_LIMIT
+                                                          : step.nudge;
+        return (static_cast<uint32_t>(note) << NOTE_SHIFT)
+               | (static_cast<uint32_t>(velocity) << VELOCITY_SHIFT)
+               | (static_cast<uint32_t>(gate) << GATE_SHIFT)
+               | (static_cast<uint32_t>(nudge + NUDGE_LIMIT) << NUDGE_SHIFT);
+    }
+
+    static constexpr uint8_t note(uint32_t word) {
+        return static_cast<uint8_t>((word >> NOTE_SHIFT) & SEVEN_BITS);
+    }
+
+    static constexpr uint8_t velocity(uint32_t word) {
+        return static_cast<uint8_t>((word >> VELOCITY_SHIFT) & SEVEN_BITS);
+    }
+
+    static constexpr uint16_t gate(uint32_t word) {
+        return static_cast<uint16_t>((word >> GATE_SHIFT) & EIGHT_BITS);
+    }
+
+    static constexpr int8_t nudge(uint32_t word) {
+        return static_cast<int8_t>(static_cast<int>((word >> NUDGE_SHIFT) & SEVEN_BITS) - NUDGE_LIMIT);
+    }
+
+    static constexpr StepFields unpack(uint32_t word) {
+        return {note(word), velocity(word), gate(word), nudge(word)};
+    }
+};
+
+static_assert(PackedStep::gate(PackedStep::pack({0, 0, 200, 0})) == 200, "gate needs 8 bits");
+static_assert(PackedStep::nudge(PackedStep::pack({0, 0, 0, -50})) == -50, "nudge is stored biased");
+static_assert(PackedStep::pack({127, 127, 200, 50}) < (uint32_t{1} << 29), "packed step uses 29 bits");
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,253 @@
+#include "ProbabilityMaskKernel.hpp"
+
+#include "StepSequencerMath.hpp"
+
+#if !defined(OC_NOTE_DISABLE_SIMD) && defined(__SSE2__)
+#define OC_NOTE_PROBABILITY_SSE2 1
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#elif !defined(OC_NOTE_DISABLE_SIMD) && defined(__ARM_NEON)
+#define OC_NOTE_PROBABILITY_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace oc::note::sequencer {
+
+namespace {
+
+// floor(x / 100) == (x * 0x51EB851F) >> 37 for every uint32_t x.
+constexpr uint32_t DIV100_MAGIC = 0x51EB851Fu;
+constexpr unsigned DIV100_SHIFT = 37;
+
+inline uint32_t mod100(uint32_t x) {
+    const uint32_t q = static_cast<uint32_t>((static_cast<uint64_t>(x) * DIV100_MAGIC) >> DIV100_SHIFT);
+    return x - q * 100U;
+}
+
+inline uint8_t threshold(uint8_t probability) {
+    return (probability > 100U) ? 100U : probability;
+}
+
+#if defined(OC_NOTE_PROBABILITY_SSE2) || defined(OC_NOTE_PROBABILITY_NEON)
+
+// Hash-input terms that do not depend on the step index.
+inline uint32_t hashBase(uint32_t runSeed, uint32_t cycleIndex) {
+    return (runSeed * 747796405u) ^ (cycleIndex * 2891336453u) ^ 0x9E3779B9u;
+}
+
+constexpr uint32_t STEP_HASH_FACTOR = 277803737u;
+
+#endif
+
+#if defined(OC_NOTE_PROBABILITY_SSE2)
+
+inline __m128i mullo32(__m128i a, __m128i b) {
+#if defined(__SSE4_1__)
+    return _mm_mullo_epi32(a, b);
+#else
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+
+/// 4 lanes of `probabilityHash(...) % 100 < threshold`, returned as 4 bits.
+inline uint32_t hashLanes(__m128i stepTerms, __m128i base, __m128i thresholds) {
+    __m128i x = _mm_xor_si128(base, stepTerms);
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    x = mullo32(x, _mm_set1_epi32(static_cast<int>(2246822519u)));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 13));
+    x = mullo32(x, _mm_set1_epi32(static_cast<int>(3266489917u)));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+
+    const __m128i magic = _mm_set1_epi32(static_cast<int>(DIV100_MAGIC));
+    const __m128i qEven = _mm_srli_epi64(_mm_mul_epu32(x, magic), DIV100_SHIFT);
+    const __m128i qOdd = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(x, 32), magic), DIV100_SHIFT);
+    const __m128i q = _mm_or_si128(qEven, _mm_slli_epi64(qOdd, 32));
+    // q * 100 == q * 64 + q * 32 + q * 4
+    const __m128i q100 = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(q, 6), _mm_slli_epi32(q, 5)),
+                                       _mm_slli_epi32(q, 2));
+    const __m128i remainder = _mm_sub_epi32(x, q100);
+
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(remainder, thresholds))));
+}
+
+/// Resolve 16 consecutive steps starting at `first`.
+inline uint32_t resolveBlock16(const ProbabilityMaskInput& input, uint8_t first, __m128i base) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i probabilities =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.probability + first));
+    const __m128i thresholds = _mm_min_epu8(probabilities, _mm_set1_epi8(100));
+
+    uint32_t liveBits = 0xFFFFu;
+    if (input.gate != nullptr) {
+        const __m128i gateLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.gate + first));
+        const __m128i gateHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.gate + first + 8));
+        const __m128i gateZero =
+            _mm_packs_epi16(_mm_cmpeq_epi16(gateLo, zero), _mm_cmpeq_epi16(gateHi, zero));
+        liveBits = ~static_cast<uint32_t>(_mm_movemask_epi8(gateZero)) & 0xFFFFu;
+    }
+
+    // 100% and 0% steps resolve by mask arithmetic; only the rest need hashing.
+    const uint32_t alwaysBits =
+        static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(thresholds, _mm_set1_epi8(100))));
+    const uint32_t neverBits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(thresholds, zero)));
+    if (((alwaysBits | neverBits) & liveBits) == liveBits) {
+        return alwaysBits & liveBits;
+    }
+
+    const __m128i t16Lo = _mm_unpacklo_epi8(thresholds, zero);
+    const __m128i t16Hi = _mm_unpackhi_epi8(thresholds, zero);
+    const __m128i t32[4] = {
+        _mm_unpacklo_epi16(t16Lo, zero),
+        _mm_unpackhi_epi16(t16Lo, zero),
+        _mm_unpacklo_epi16(t16Hi, zero),
+        _mm_unpackhi_epi16(t16Hi, zero),
+    };
+
+    const uint32_t firstTerm = static_cast<uint32_t>(first) * STEP_HASH_FACTOR;
+    __m128i stepTerms = _mm_setr_epi32(static_cast<int>(firstTerm),
+                                       static_cast<int>(firstTerm + STEP_HASH_FACTOR),
+                                       static_cast<int>(firstTerm + 2U * STEP_HASH_FACTOR),
+                                       static_cast<int>(firstTerm + 3U * STEP_HASH_FACTOR));
+    const __m128i stepTermStride = _mm_set1_epi32(static_cast<int>(4U * STEP_HASH_FACTOR));
+
+    uint32_t hashBits = 0;
+    for (unsigned lane = 0; lane < 4; ++lane) {
+        hashBits |= hashLanes(stepTerms, base, t32[lane]) << (lane * 4U);
+        stepTerms = _mm_add_epi32(stepTerms, stepTermStride);
+    }
+
+    return hashBits & liveBits;
+}
+
+#elif defined(OC_NOTE_PROBABILITY_NEON)
+
+/// 4 lanes of `probabilityHash(...) % 100 < threshold`, returned as 4 bits.
+inline uint32_t hashLanes(uint32x4_t stepTerms, uint32x4_t base, uint32x4_t thresholds) {
+    uint32x4_t x = veorq_u32(base, stepTerms);
+    x = veorq_u32(x, vshrq_n_u32(x, 16));
+    x = vmulq_n_u32(x, 2246822519u);
+    x = veorq_u32(x, vshrq_n_u32(x, 13));
+    x = vmulq_n_u32(x, 3266489917u);
+    x = veorq_u32(x, vshrq_n_u32(x, 16));
+
+    const uint32x2_t magic = vdup_n_u32(DIV100_MAGIC);
+    const uint32x2_t qLo = vshr_n_u32(vshrn_n_u64(vmull_u32(vget_low_u32(x), magic), 32), DIV100_SHIFT - 32);
+    const uint32x2_t qHi = vshr_n_u32(vshrn_n_u64(vmull_u32(vget_high_u32(x), magic), 32), DIV100_SHIFT - 32);
+    const uint32x4_t remainder = vmlsq_n_u32(x, vcombine_u32(qLo, qHi), 100U);
+
+    const uint32x4_t hit = vcltq_u32(remainder, thresholds);
+    const uint32x4_t laneBits = {1U, 2U, 4U, 8U};
+    const uint32x4_t bits = vandq_u32(hit, laneBits);
+    const uint32x2_t pair = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return vget_lane_u32(vpadd_u32(pair, pair), 0);
+}
+
+/// Resolve 16 consecutive steps starting at `first`.
+inline uint32_t resolveBlock16(const ProbabilityMaskInput& input, uint8_t first, uint32x4_t base) {
+    const uint8x16_t thresholds = vminq_u8(vld1q_u8(input.probability + first), vdupq_n_u8(100));
+
+    uint32_t liveBits = 0;
+    uint32_t alwaysBits = 0;
+    uint32_t neverBits = 0;
+    for (uint8_t i = 0; i < 16; ++i) {
+        const uint8_t t = threshold(input.probability[first + i]);
+        liveBits |= static_cast<uint32_t>(input.gate == nullptr || input.gate[first + i] != 0) << i;
+        alwaysBits |= static_cast<uint32_t>(t == 100U) << i;
+        neverBits |= static_cast<uint32_t>(t == 0U) << i;
+    }
+    // 100% and 0% steps resolve by mask arithmetic; only the rest need hashing.
+    if (((alwaysBits | neverBits) & liveBits) == liveBits) {
+        return alwaysBits & liveBits;
+    }
+
+    const uint16x8_t t16Lo = vmovl_u8(vget_low_u8(thresholds));
+    const uint16x8_t t16Hi = vmovl_u8(vget_high_u8(thresholds));
+    const uint32x4_t t32[4] = {
+        vmovl_u16(vget_low_u16(t16Lo)),
+        vmovl_u16(vget_high_u16(t16Lo)),
+        vmovl_u16(vget_low_u16(t16Hi)),
+        vmovl_u16(vget_high_u16(t16Hi)),
+    };
+
+    const uint32_t firstTerm = static_cast<uint32_t>(first) * STEP_HASH_FACTOR;
+    uint32x4_t stepTerms = {firstTerm,
+                            firstTerm + STEP_HASH_FACTOR,
+                            firstTerm + 2U * STEP_HASH_FACTOR,
+                            firstTerm + 3U * STEP_HASH_FACTOR};
+    const uint32x4_t stepTermStride = vdupq_n_u32(4U * STEP_HASH_FACTOR);
+
+    uint32_t hashBits = 0;
+    for (unsigned lane = 0; lane < 4; ++lane) {
+        hashBits |= hashLanes(stepTerms, base, t32[lane]) << (lane * 4U);
+        stepTerms = vaddq_u32(stepTerms, stepTermStride);
+    }
+
+    return hashBits & liveBits;
+}
+
+#endif
+
+}  // namespace
+
+StepBitMask128 resolveProbabilityMaskScalar(const ProbabilityMaskInput& input) {
+    if (input.length == 0) return {};
+
+    const StepBitMask128 candidates = input.enabledMask & StepBitMask128::prefixMask(input.length);
+    const uint64_t words[2] = {candidates.low, candidates.high};
+    uint64_t resolved[2] = {0, 0};
+
+    for (uint8_t word = 0; word < 2; ++word) {
+        uint64_t bits = words[word];
+        while (bits != 0) {
+            const uint8_t bit = static_cast<uint8_t>(__builtin_ctzll(bits));
+            bits &= bits - 1U;
+
+            const uint8_t stepIndex = static_cast<uint8_t>(word * 64U + bit);
+            if (input.gate != nullptr && input.gate[stepIndex] == 0) continue;
+
+            const uint8_t t = threshold(input.probability[stepIndex]);
+            if (t == 0U) continue;
+            if (t >= 100U || mod100(probabilityHash(input.runSeed, input.cycleIndex, stepIndex)) < t) {
+                resolved[word] |= uint64_t{1} << bit;
+            }
+        }
+    }
+
+    return {.low = resolved[0], .high = resolved[1]};
+}
+
+StepBitMask128 resolveProbabilityMask(const ProbabilityMaskInput& input) {
+#if defined(OC_NOTE_PROBABILITY_SSE2) || defined(OC_NOTE_PROBABILITY_NEON)
+    if (input.length == 0) return {};
+
+    const StepBitMask128 candidates = input.enabledMask & StepBitMask128::prefixMask(input.length);
+    const uint32_t baseTerm = hashBase(input.runSeed, input.cycleIndex);
+#if defined(OC_NOTE_PROBABILITY_SSE2)
+    const __m128i base = _mm_set1_epi32(static_cast<int>(baseTerm));
+#else
+    const uint32x4_t base = vdupq_n_u32(baseTerm);
+#endif
+
+    uint64_t resolved[2] = {0, 0};
+    for (uint16_t first = 0; first < input.length; first += 16U) {
+        const uint8_t word = static_cast<uint8_t>(first / 64U);
+        const uint8_t shift = static_cast<uint8_t>(first % 64U);
+        const uint64_t live = (((word == 0) ? candidates.low : candidates.high) >> shift) & 0xFFFFu;
+        if (live == 0) continue;
+
+        const uint32_t bits = resolveBlock16(input, static_cast<uint8_t>(first), base);
+        resolved[word] |= (static_cast<uint64_t>(bits) & live) << shift;
+    }
+
+    return {.low = resolved[0], .high = resolved[1]};
+#else
+    return resolveProbabilityMaskScalar(input);
+#endif
+}
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include "StepBitMask128.hpp"
+
+namespace oc::note::sequencer {
+
+struct ProbabilityMaskInput {
+    /// Per-step probability percent; readable up to `length` rounded up to 16.
+    const uint8_t* probability = nullptr;
+    /// Per-step gate percent; readable up to `length` rounded up to 16. nullptr treats
+    /// every step as gated, for callers that fold silent steps out of `enabledMask`.
+    const uint16_t* gate = nullptr;
+    StepBitMask128 enabledMask{};
+    uint8_t length = 0;
+    uint32_t runSeed = 0;
+    uint32_t cycleIndex = 0;
+};
+
+/**
+ * @brief Resolve which steps fire in one probability cycle
+ *
+ * Bit i is set when step i < length is enabled, has a non-zero gate, and
+ * `probabilityHash(runSeed, cycleIndex, i) % 100 < min(probability[i], 100)`.
+ * Uses SSE2/NEON lanes when available; every path yields identical bits.
+ */
+StepBitMask128 resolveProbabilityMask(const ProbabilityMaskInput& input);
+
+/// Portable path; hashes only steps whose probability is strictly between 0 and 100.
+StepBitMask128 resolveProbabilityMaskScalar(const ProbabilityMaskInput& input);
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <oc/note/clock/ClockConstants.hpp>
+
+#include "StepBitMask.hpp"
+
+namespace oc::note::sequencer {
+
+/**
+ * @brief Compile-time sizing for the templated sequencer types
+ *
+ * `MaxSteps` sizes every per-step array and picks the mask type, so a
+ * 16-step lane stores 16 steps and one 32-bit mask word instead of 128 steps
+ * and two 64-bit words. `MaxEventsPerTrack` sizes the scheduler and
+ * `TicksPerQuarter` is the starting tick resolution (`setTicksPerQuarter`
+ * still changes it at runtime).
+ *
+ * The probability kernel reads steps in blocks of 16, so `MaxSteps` is a
+ * multiple of 16.
+ */
+template <uint8_t MaxSteps = StepBitMask128::BITS,
+          size_t MaxEventsPerTrack = 8,
+          uint16_t TicksPerQuarter = oc::note::clock::PPQN>
+struct SequencerConfig {
+    static_assert(MaxSteps >= 16 && MaxSteps <= StepBitMask128::BITS,
+                  "SequencerConfig steps must be between 16 and 128");
+    static_assert(MaxSteps % 16 == 0, "SequencerConfig steps must be a multiple of 16");
+    static_assert(MaxEventsPerTrack >= 2, "SequencerConfig needs room for a NoteOn/NoteOff pair");
+
+    static constexpr uint8_t MAX_STEPS = MaxSteps;
+    static constexpr size_t MAX_EVENTS_PER_TRACK = MaxEventsPerTrack;
+    static constexpr uint16_t TICKS_PER_QUARTER = oc::note::clock::normalizeTicksPerQuarter(TicksPerQuarter);
+
+    using StepMask = StepBitMask<MaxSteps>;
+};
+
+/// 128 steps per track, as in `StepSequencerRuntimeState` and `StepSequencerState`.
+using DefaultSequencerConfig = SequencerConfig<>;
+
+/// 16-step drum lanes.
+using DrumLaneSequencerConfig = SequencerConfig<16>;
+
+}  // namespace oc::note::sequencer
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace oc::note::sequencer {
@@ -8,6 +9,8 @@ enum class SequencerEventType : uint8_t {
     NoteOn,
     NoteOff,
     AllNotesOff,
+    /// `note` carries the controller number and `velocity` the value.
+    ControlChange,
 };
 
 struct SequencerEvent {
@@ -21,6 +24,19 @@ struct SequencerEvent {
 struct ISequencerEventSink {
     virtual ~ISequencerEventSink() = default;
     virtual bool emitSequencerEvent(const SequencerEvent& event) = 0;
+
+    /**
+     * @brief Emit a contiguous, time-ordered span of events
+     *
+     * Returns how many leading events were accepted; the rest stay queued.
+     * Override to consume a whole batch with one call.
+     */
+    virtual size_t emitSequencerEvents(const SequencerEvent* events, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!emitSequencerEvent(events[i])) return i;
+        }
+        return count;
+    }
 };
 
 }  // namespace oc::note::sequencer
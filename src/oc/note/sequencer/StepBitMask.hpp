@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "StepBitMask128.hpp"
+
+namespace oc::note::sequencer {
+
+/**
+ * @brief Step mask held in one machine word, for patterns of at most 64 steps
+ *
+ * Same interface as `StepBitMask128`. Bits at or above `Bits` are never set,
+ * so `~` and `prefixMask` stay within the pattern and `count` needs no mask.
+ */
+template <typename Word, uint8_t Bits>
+struct StepBitMaskWord {
+    static_assert(std::is_unsigned<Word>::value, "StepBitMaskWord needs an unsigned word");
+    static_assert(Bits > 0 && Bits <= sizeof(Word) * 8U, "StepBitMaskWord bits must fit in its word");
+
+    static constexpr uint8_t BITS = Bits;
+    static constexpr Word ALL = (Bits == sizeof(Word) * 8U) ? static_cast<Word>(~Word{0})
+                                                             : static_cast<Word>((Word{1} << Bits) - 1U);
+
+    Word bits = 0;
+
+    constexpr bool operator==(const StepBitMaskWord& other) const { return bits == other.bits; }
+    constexpr bool operator!=(const StepBitMaskWord& other) const { return bits != other.bits; }
+
+    constexpr StepBitMaskWord operator&(const StepBitMaskWord& other) const {
+        return {static_cast<Word>(bits & other.bits)};
+    }
+
+    constexpr StepBitMaskWord operator|(const StepBitMaskWord& other) const {
+        return {static_cast<Word>(bits | other.bits)};
+    }
+
+    constexpr StepBitMaskWord operator^(const StepBitMaskWord& other) const {
+        return {static_cast<Word>(bits ^ other.bits)};
+    }
+
+    constexpr StepBitMaskWord operator~() const { return {static_cast<Word>(~bits & ALL)}; }
+
+    constexpr StepBitMaskWord& operator&=(const StepBitMaskWord& other) {
+        bits &= other.bits;
+        return *this;
+    }
+
+    constexpr StepBitMaskWord& operator|=(const StepBitMaskWord& other) {
+        bits |= other.bits;
+        return *this;
+    }
+
+    constexpr StepBitMaskWord& operator^=(const StepBitMaskWord& other) {
+        bits ^= other.bits;
+        return *this;
+    }
+
+    /// Bits at or above `Bits` are dropped.
+    static constexpr StepBitMaskWord fromLower64(uint64_t value) {
+        return {static_cast<Word>(value & ALL)};
+    }
+
+    static constexpr StepBitMaskWord prefixMask(uint8_t length) {
+        if (length >= Bits) return {ALL};
+        return {static_cast<Word>((Word{1} << length) - 1U)};
+    }
+
+    constexpr uint64_t lower64() const { return bits; }
+
+    constexpr bool any() const { return bits != 0; }
+
+    uint8_t count() const { return static_cast<uint8_t>(__builtin_popcountll(bits)); }
+
+    /// Number of set bits below `index` (its position among the set bits).
+    uint8_t rank(uint8_t index) const {
+        if (index >= Bits) return count();
+        return static_cast<uint8_t>(__builtin_popcountll(bits & ((Word{1} << index) - 1U)));
+    }
+
+    /// Lowest set bit at or after `from`; `BITS` when there is none.
+    uint8_t findNextSet(uint8_t from) const {
+        if (from >= Bits) return BITS;
+        const Word above = static_cast<Word>(bits & static_cast<Word>(~Word{0} << from));
+        return (above != 0) ? static_cast<uint8_t>(__builtin_ctzll(above)) : BITS;
+    }
+
+    /// Rotate the low `width` bits so step i moves to (i + amount) % width; bits above are cleared.
+    constexpr StepBitMaskWord rotateLeft(uint8_t amount, uint8_t width = Bits) const {
+        if (width == 0) return {};
+        const uint8_t w = (width > Bits) ? Bits : width;
+        const uint8_t a = static_cast<uint8_t>(amount % w);
+        const Word inside = prefixMask(w).bits & bits;
+        if (a == 0) return {inside};
+        return {static_cast<Word>(((inside << a) | (inside >> (w - a))) & prefixMask(w).bits)};
+    }
+
+    /// Inverse of `rotateLeft`: step i moves to (i - amount) mod width.
+    constexpr StepBitMaskWord rotateRight(uint8_t amount, uint8_t width = Bits) const {
+        if (width == 0) return {};
+        const uint8_t w = (width > Bits) ? Bits : width;
+        return rotateLeft(static_cast<uint8_t>(w - amount % w), w);
+    }
+
+    constexpr bool test(uint8_t index) const {
+        return index < Bits && (bits & (Word{1} << index)) != 0;
+    }
+
+    constexpr void setBit(uint8_t index, bool enabled = true) {
+        if (index >= Bits) return;
+        const Word bit = static_cast<Word>(Word{1} << index);
+        if (enabled) bits |= bit;
+        else bits &= static_cast<Word>(~bit);
+    }
+
+    constexpr void toggleBit(uint8_t index) {
+        if (index >= Bits) return;
+        bits ^= static_cast<Word>(Word{1} << index);
+    }
+};
+
+/**
+ * @brief Smallest step mask holding `Steps` bits
+ *
+ * One `uint32_t` up to 32 steps, one `uint64_t` up to 64, `StepBitMask128`
+ * above that. All three share one interface, so code templated on the mask
+ * type compiles the single-word forms without any high-word branches.
+ */
+template <uint8_t Steps>
+using StepBitMask = std::conditional_t<
+    (Steps <= 32U),
+    StepBitMaskWord<uint32_t, Steps>,
+    std::conditional_t<(Steps <= 64U), StepBitMaskWord<uint64_t, Steps>, StepBitMask128>>;
+
+static_assert(sizeof(StepBitMask<16>) == 4, "16-step masks fit one 32-bit word");
+static_assert(sizeof(StepBitMask<64>) == 8, "64-step masks fit one 64-bit word");
+static_assert(std::is_same<StepBitMask<128>, StepBitMask128>::value, "128-step masks are StepBitMask128");
+
+/// Widen any step mask to the 128-step form the shared kernels take.
+template <typename Word, uint8_t Bits>
+constexpr StepBitMask128 toStepBitMask128(const StepBitMaskWord<Word, Bits>& mask) {
+    return StepBitMask128::fromLower64(mask.bits);
+}
+
+constexpr StepBitMask128 toStepBitMask128(const StepBitMask128& mask) {
+    return mask;
+}
+
+/// Narrow a 128-step mask to `Mask`, dropping steps it cannot hold.
+template <typename Mask>
+constexpr Mask fromStepBitMask128(const StepBitMask128& mask) {
+    if constexpr (std::is_same<Mask, StepBitMask128>::value) {
+        return mask;
+    } else {
+        return Mask::fromLower64(mask.low);
+    }
+}
+
+}  // namespace oc::note::sequencer
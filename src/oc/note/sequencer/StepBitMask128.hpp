@@ -5,6 +5,8 @@
 namespace oc::note::sequencer {
 
 struct StepBitMask128 {
+    static constexpr uint8_t BITS = 128;
+
     uint64_t low = 0;
     uint64_t high = 0;
 
@@ -82,6 +84,49 @@ struct StepBitMask128 {
         return low != 0 || high != 0;
     }
 
+    uint8_t count() const {
+        return static_cast<uint8_t>(__builtin_popcountll(low) + __builtin_popcountll(high));
+    }
+
+    /// Number of set bits below `index` (its position among the set bits).
+    uint8_t rank(uint8_t index) const {
+        if (index >= 128U) return count();
+        if (index < 64U) {
+            return static_cast<uint8_t>(__builtin_popcountll(low & ((uint64_t{1} << index) - 1U)));
+        }
+        const uint64_t highBelow = high & ((uint64_t{1} << (index - 64U)) - 1U);
+        return static_cast<uint8_t>(__builtin_popcountll(low) + __builtin_popcountll(highBelow));
+    }
+
+    /// Lowest set bit at or after `from`; `BITS` when there is none.
+    uint8_t findNextSet(uint8_t from) const {
+        if (from >= 128U) return BITS;
+        if (from < 64U) {
+            const uint64_t bits = low & (~uint64_t{0} << from);
+            if (bits != 0) return static_cast<uint8_t>(__builtin_ctzll(bits));
+            from = 64U;
+        }
+        const uint64_t bits = high & (~uint64_t{0} << (from - 64U));
+        return (bits != 0) ? static_cast<uint8_t>(64U + __builtin_ctzll(bits)) : BITS;
+    }
+
+    /// Rotate the low `width` bits so step i moves to (i + amount) % width; bits above are cleared.
+    constexpr StepBitMask128 rotateLeft(uint8_t amount, uint8_t width = BITS) const {
+        if (width == 0) return {};
+        const uint8_t w = (width > 128U) ? BITS : width;
+        const uint8_t a = static_cast<uint8_t>(amount % w);
+        const StepBitMask128 inside = *this & prefixMask(w);
+        if (a == 0) return inside;
+        return (shiftLeft_(inside, a) | shiftRight_(inside, static_cast<uint8_t>(w - a))) & prefixMask(w);
+    }
+
+    /// Inverse of `rotateLeft`: step i moves to (i - amount) mod width.
+    constexpr StepBitMask128 rotateRight(uint8_t amount, uint8_t width = BITS) const {
+        if (width == 0) return {};
+        const uint8_t w = (width > 128U) ? BITS : width;
+        return rotateLeft(static_cast<uint8_t>(w - amount % w), w);
+    }
+
     constexpr bool test(uint8_t index) const {
         if (index >= 128U) return false;
         if (index < 64U) return (low & (uint64_t{1} << index)) != 0;
@@ -109,6 +154,21 @@ struct StepBitMask128 {
         }
         high ^= (uint64_t{1} << (index - 64U));
     }
+
+private:
+    static constexpr StepBitMask128 shiftLeft_(const StepBitMask128& mask, uint8_t n) {
+        if (n >= 128U) return {};
+        if (n >= 64U) return {.low = 0, .high = mask.low << (n - 64U)};
+        if (n == 0) return mask;
+        return {.low = mask.low << n, .high = (mask.high << n) | (mask.low >> (64U - n))};
+    }
+
+    static constexpr StepBitMask128 shiftRight_(const StepBitMask128& mask, uint8_t n) {
+        if (n >= 128U) return {};
+        if (n >= 64U) return {.low = mask.high >> (n - 64U), .high = 0};
+        if (n == 0) return mask;
+        return {.low = (mask.low >> n) | (mask.high << (64U - n)), .high = mask.high >> n};
+    }
 };
 
 static_assert(sizeof(StepBitMask128) == 16, "StepBitMask128 must stay compact");
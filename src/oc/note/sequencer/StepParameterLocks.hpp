@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "StepBitMask128.hpp"
+
+namespace oc::note::sequencer {
+
+/**
+ * @brief Sparse per-step CC locks
+ *
+ * Each lane is one controller with a presence mask over the steps. Values of
+ * all lanes share one packed array: lane `l` owns `values[base[l] ..
+ * base[l] + present[l].count())` in step order, so a step's value sits at
+ * `base[l] + present[l].rank(step)`. Storage grows with the number of locks,
+ * never with steps x controllers.
+ */
+struct StepParameterLocks {
+    static constexpr uint8_t MAX_LANES = 8;
+    static constexpr uint16_t MAX_LOCKS = 256;
+    static constexpr uint8_t NO_CONTROLLER = 0xFF;
+    /// `restoreValue` meaning "leave the controller where the last lock put it".
+    static constexpr uint8_t NO_RESTORE = 0xFF;
+
+    std::array<uint8_t, MAX_LANES> controller{};
+    /// Sent on the first triggered step after a locked one; `NO_RESTORE` to skip.
+    std::array<uint8_t, MAX_LANES> restoreValue{};
+    std::array<StepBitMask128, MAX_LANES> present{};
+    std::array<uint16_t, MAX_LANES> base{};
+    std::array<uint8_t, MAX_LOCKS> values{};
+    uint16_t used = 0;
+    /// Bit l set while lane l holds a controller.
+    uint8_t activeLanes = 0;
+
+    StepParameterLocks() { clear(); }
+
+    void clear() {
+        controller.fill(NO_CONTROLLER);
+        restoreValue.fill(NO_RESTORE);
+        present.fill({});
+        base.fill(0);
+        used = 0;
+        activeLanes = 0;
+    }
+
+    /// Lane holding `cc`, or `MAX_LANES` when it has no locks.
+    uint8_t laneOf(uint8_t cc) const {
+        for (uint8_t lane = 0; lane < MAX_LANES; ++lane) {
+            if (controller[lane] == cc) return lane;
+        }
+        return MAX_LANES;
+    }
+
+    bool isLocked(uint8_t lane, uint8_t step) const { return lane < MAX_LANES && present[lane].test(step); }
+
+    uint8_t value(uint8_t lane, uint8_t step) const { return values[base[lane] + present[lane].rank(step)]; }
+
+    /// Lock `cc` to `ccValue` on `step`; false when out of lanes or value slots.
+    bool set(uint8_t step, uint8_t cc, uint8_t ccValue) {
+        if (step >= 128U || cc == NO_CONTROLLER) return false;
+
+        uint8_t lane = laneOf(cc);
+        if (lane == MAX_LANES) {
+            lane = laneOf(NO_CONTROLLER);
+            if (lane == MAX_LANES) return false;
+            controller[lane] = cc;
+            activeLanes = static_cast<uint8_t>(activeLanes | (1U << lane));
+        }
+
+        const uint16_t at = static_cast<uint16_t>(base[lane] + present[lane].rank(step));
+        if (present[lane].test(step)) {
+            values[at] = ccValue;
+            return true;
+        }
+        if (used >= MAX_LOCKS) {
+            if (!present[lane].any()) releaseLane_(lane);
+            return false;
+        }
+
+        for (uint16_t i = used; i > at; --i) {
+            values[i] = values[i - 1U];
+        }
+        values[at] = ccValue;
+        shiftBasesAfter_(lane, 1);
+        present[lane].setBit(step);
+        return true;
+    }
+
+    /// Remove the lock of `cc` on `step`; false when there was none.
+    bool remove(uint8_t step, uint8_t cc) {
+        const uint8_t lane = laneOf(cc);
+        if (!isLocked(lane, step)) return false;
+
+        const uint16_t at = static_cast<uint16_t>(base[lane] + present[lane].rank(step));
+        for (uint16_t i = at; i + 1U < used; ++i) {
+            values[i] = values[i + 1U];
+        }
+        shiftBasesAfter_(lane, -1);
+        present[lane].setBit(step, false);
+        if (!present[lane].any()) releaseLane_(lane);
+        return true;
+    }
+
+    /// Set the value sent after `cc`'s locked steps; false when `cc` has no locks.
+    bool setRestore(uint8_t cc, uint8_t ccValue) {
+        const uint8_t lane = laneOf(cc);
+        if (lane == MAX_LANES || cc == NO_CONTROLLER) return false;
+        restoreValue[lane] = ccValue;
+        return true;
+    }
+
+private:
+    void shiftBasesAfter_(uint8_t lane, int delta) {
+        for (uint8_t other = static_cast<uint8_t>(lane + 1U); other < MAX_LANES; ++other) {
+            base[other] = static_cast<uint16_t>(base[other] + delta);
+        }
+        used = static_cast<uint16_t>(used + delta);
+    }
+
+    void releaseLane_(uint8_t lane) {
+        controller[lane] = NO_CONTROLLER;
+        restoreValue[lane] = NO_RESTORE;
+        activeLanes = static_cast<uint8_t>(activeLanes & ~(1U << lane));
+    }
+};
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <oc/note/clock/ClockConstants.hpp>
+
+#include "SequencerEvent.hpp"
+#include "StepSequencerEngine.hpp"
+#include "StepSequencerRuntimeState.hpp"
+
+namespace oc::note::sequencer {
+
+/// One headless render: `pattern` from transport start over `tickCount` ticks into `sink`.
+struct BatchRenderJob {
+    const StepSequencerRuntimeState* pattern = nullptr;
+    ISequencerEventSink* sink = nullptr;
+    uint32_t tickCount = 0;
+    uint32_t runSeed = 1;
+    uint16_t ticksPerQuarter = oc::note::clock::PPQN;
+
+    // Written by the runner.
+    uint32_t eventCount = 0;
+    bool complete = false;  // every event was accepted by `sink`
+};
+
+/**
+ * @brief Renders many independent patterns across worker threads (host builds)
+ *
+ * Each job runs a private engine over a copy of its pattern, through
+ * `renderRange`, on whichever worker picks it up, and hands its events to
+ * its own sink in time order. A job's output therefore does not depend on
+ * the worker count or on scheduling, so reading the sinks in job order gives
+ * the same stream every run. Jobs sharing a sink must share a thread-safe one.
+ *
+ * Jobs are split into one contiguous range per worker. A worker takes jobs
+ * from its own range through an atomic cursor, then steals from the other
+ * ranges' cursors, so uneven jobs still balance. Claiming a job takes no lock.
+ *
+ * The worker threads start with the runner and sleep between runs; a mutex
+ * and two condition variables only start a run and wait for its end. Workers
+ * keep their pattern copy and event buffer too, so a run allocates nothing.
+ * The calling thread is worker 0. Call `run` from one thread at a time.
+ *
+ * Uses `std::thread`; header-only so embedded builds never compile it. Link
+ * `Threads::Threads` into targets that include it.
+ */
+class StepSequencerBatchRunner {
+public:
+    static constexpr size_t EVENT_BUFFER_SIZE = 256;
+
+    /// `workerCount` 0 picks the hardware concurrency.
+    explicit StepSequencerBatchRunner(unsigned workerCount = 0) {
+        if (workerCount == 0) workerCount = std::max(1U, std::thread::hardware_concurrency());
+        workers_.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i) workers_.push_back(std::make_unique<Worker_>());
+
+        threads_.reserve(workerCount - 1U);
+        for (unsigned w = 1; w < workerCount; ++w) {
+            threads_.emplace_back([this, w] { serve_(w); });
+        }
+    }
+
+    ~StepSequencerBatchRunner() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        start_.notify_all();
+        for (auto& thread : threads_) thread.join();
+    }
+
+    StepSequencerBatchRunner(const StepSequencerBatchRunner&) = delete;
+    StepSequencerBatchRunner& operator=(const StepSequencerBatchRunner&) = delete;
+
+    unsigned workerCount() const { return static_cast<unsigned>(workers_.size()); }
+
+    /// Render every job and return once all are done.
+    void run(BatchRenderJob* jobs, size_t count) {
+        if (jobs == nullptr || count == 0) return;
+
+        const size_t active = std::min(workers_.size(), count);
+        for (size_t w = 0; w < active; ++w) {
+            workers_[w]->next.store(count * w / active, std::memory_order_relaxed);
+            workers_[w]->end = count * (w + 1U) / active;
+        }
+
+        if (active > 1U) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                jobs_ = jobs;
+                active_ = active;
+                running_ = active - 1U;
+                ++generation_;
+            }
+            start_.notify_all();
+        }
+
+        work_(jobs, active, 0);
+
+        if (active > 1U) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            finished_.wait(lock, [this] { return running_ == 0; });
+        }
+    }
+
+private:
+    /// renderRange never emits through the sink; this only satisfies the engine type.
+    struct NullSink_ {
+        bool emitSequencerEvent(const SequencerEvent&) { return true; }
+        size_t emitSequencerEvents(const SequencerEvent*, size_t count) { return count; }
+    };
+
+    struct Worker_ {
+        alignas(64) std::atomic<size_t> next{0};
+        size_t end = 0;
+        StepSequencerRuntimeState state{};
+        std::array<SequencerEvent, EVENT_BUFFER_SIZE> events{};
+    };
+
+    /// Worker thread `self`: wait for a run, take part if the run uses it, report back.
+    void serve_(size_t self) {
+        uint64_t seen = 0;
+        for (;;) {
+            BatchRenderJob* jobs = nullptr;
+            size_t active = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [this, seen] { return stopping_ || generation_ != seen; });
+                if (stopping_) return;
+                seen = generation_;
+                jobs = jobs_;
+                active = active_;
+            }
+            if (self >= active) continue;
+
+            work_(jobs, active, self);
+
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                last = --running_ == 0;
+            }
+            if (last) finished_.notify_one();
+        }
+    }
+
+    void work_(BatchRenderJob* jobs, size_t active, size_t self) {
+        Worker_& worker = *workers_[self];
+        for (size_t k = 0; k < active; ++k) {
+            Worker_& victim = *workers_[(self + k) % active];
+            for (;;) {
+                const size_t index = victim.next.fetch_add(1, std::memory_order_relaxed);
+                if (index >= victim.end) break;
+                render_(worker, jobs[index]);
+            }
+        }
+    }
+
+    static void render_(Worker_& worker, BatchRenderJob& job) {
+        job.eventCount = 0;
+        job.complete = false;
+        if (job.pattern == nullptr || job.sink == nullptr) return;
+
+        worker.state = *job.pattern;
+        NullSink_ sink;
+        BasicStepSequencerEngine<NullSink_> engine(worker.state, sink);
+        engine.setNextRunSeed(job.runSeed);
+        engine.setTicksPerQuarter(job.ticksPerQuarter);
+
+        RenderRangeResult rendered{};
+        do {
+            rendered = engine.renderRange(0, job.tickCount, worker.events.data(), worker.events.size());
+            const size_t accepted = job.sink->emitSequencerEvents(worker.events.data(), rendered.eventCount);
+            job.eventCount += static_cast<uint32_t>(accepted);
+            if (accepted < rendered.eventCount) return;
+        } while (!rendered.complete);
+        job.complete = true;
+    }
+
+    std::vector<std::unique_ptr<Worker_>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable finished_;
+    // Guarded by `mutex_`.
+    BatchRenderJob* jobs_ = nullptr;
+    size_t active_ = 0;
+    size_t running_ = 0;
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+};
+
+}  // namespace oc::note::sequencer
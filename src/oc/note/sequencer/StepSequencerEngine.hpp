@@ -1,66 +1,1086 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 #include <oc/note/clock/ClockConstants.hpp>
 
+#include "CompiledStepPattern.hpp"
 #include "NoteScheduler.hpp"
+#include "ProbabilityMaskKernel.hpp"
 #include "SequencerEvent.hpp"
+#include "StepSequencerMath.hpp"
 #include "StepSequencerRuntimeState.hpp"
+#include "StepSequencerStateExchange.hpp"
+#include "StepSequencerStats.hpp"
 
 namespace oc::note::sequencer {
 
-class StepSequencerEngine {
+struct RenderRangeResult {
+    size_t eventCount = 0;
+    bool complete = true;
+};
+
+/// Where an audio block sits on the tick timeline, for `renderBlock`.
+struct AudioBlockTiming {
+    uint32_t startTick = 0;        // clock tick at the block's first sample
+    float startTickPhase = 0.0f;   // fraction of `startTick` already elapsed, in [0, 1)
+    float sampleRate = 48'000.0f;
+    uint32_t blockSize = 0;        // samples
+    float bpm = 120.0f;
+};
+
+/**
+ * @brief Mono-track step sequencer engine
+ *
+ * `Sink` receives the output. The default `StepSequencerEngine` alias uses the
+ * virtual `ISequencerEventSink`; instantiate with a concrete (ideally `final`)
+ * sink type to let the compiler inline the emit path. A sink type must provide
+ * `bool emitSequencerEvent(const SequencerEvent&)` and
+ * `size_t emitSequencerEvents(const SequencerEvent*, size_t)`.
+ *
+ * `Scheduler` is a `BasicNoteScheduler`; pick a smaller capacity and an
+ * `OverflowPolicy` other than `ClearAll` to keep playing through overflow
+ * instead of cutting every sounding note.
+ *
+ * `StateType` is a `BasicStepSequencerRuntimeState`; a smaller
+ * `SequencerConfig` shrinks both it and the engine's compiled step table.
+ * Only the default 128-step state can take edits through `setStateSource`.
+ */
+template <typename Sink, typename Scheduler = NoteScheduler, typename StateType = StepSequencerRuntimeState>
+class BasicStepSequencerEngine {
 public:
-    StepSequencerEngine(StepSequencerRuntimeState& state, ISequencerEventSink& eventSink)
+    using State = StateType;
+    using StepMask = typename State::StepMask;
+
+    BasicStepSequencerEngine(State& state, Sink& eventSink)
         : state_(state)
         , event_sink_(eventSink) {}
 
     void reset();
+
+    /**
+     * @brief Jump playback to `tick` (e.g. a song-position change)
+     *
+     * Sends AllNotesOff, then re-sounds every note whose gate spans `tick`
+     * (NoteOn at `tick`, NoteOff at its original release) and schedules ahead
+     * from there. Cost is constant per step examined; probability masks are
+     * resolved directly for the target cycle.
+     */
     void resyncToTick(uint32_t tick);
 
     void update(uint32_t tick, bool playing);
 
+    /**
+     * @brief Render every event due in [fromTick, toTick) into `out`
+     *
+     * Equivalent to driving `update(tick, true)` up to `toTick - 1`, except that
+     * events are written in time order to the caller's buffer instead of the
+     * sink. When `out` fills up the result is incomplete; call again with the
+     * same window to resume where rendering stopped. Nothing is dropped: an
+     * AllNotesOff that did not fit is written first on the next call.
+     *
+     * A window that does not continue from the last rendered tick, forwards or
+     * backwards, is a jump: like `resyncToTick(fromTick)`, it sends AllNotesOff
+     * and re-sounds the notes held at `fromTick`, so no event before `fromTick`
+     * is rendered. The first
+     * window after a stop starts playback at `fromTick` the same way, without
+     * the AllNotesOff.
+     */
+    RenderRangeResult renderRange(uint32_t fromTick,
+                                  uint32_t toTick,
+                                  SequencerEvent* out,
+                                  size_t capacity);
+
+    /**
+     * @brief Render one audio block with each event's sample offset inside it
+     *
+     * Renders the ticks that fall inside the block (`renderRange` over
+     * [ceil(start), ceil(end))) and writes, per event, the sample at which its
+     * tick lands given the block's fractional start position, tempo and the
+     * engine's ticks-per-quarter. Offsets are in [0, blockSize); an event left
+     * over from an earlier block lands on sample 0. Feed consecutive blocks
+     * from the same clock; when `out` fills up, call again with the same block.
+     * A tick skipped or repeated between two blocks by rounding is absorbed by
+     * the later block rather than treated as a jump.
+     */
+    RenderRangeResult renderBlock(const AudioBlockTiming& block,
+                                  SequencerEvent* out,
+                                  uint32_t* sampleOffsets,
+                                  size_t capacity);
+
     bool isPlaying() const { return playing_; }
 
+    /**
+     * @brief Resolution of the ticks passed to `update`/`renderRange`
+     *
+     * Defaults to the 24-PPQN MIDI clock. Raise it (e.g. to 960, matching the
+     * clock driving the engine) for finer nudge and gate timing; it is rounded
+     * down to a multiple of `clock::PPQN`. Change it only while stopped.
+     */
+    void setTicksPerQuarter(uint16_t ticksPerQuarter) {
+        ticks_per_quarter_ = oc::note::clock::normalizeTicksPerQuarter(ticksPerQuarter);
+        compiled_.invalidate();
+    }
+
+    uint16_t ticksPerQuarter() const { return ticks_per_quarter_; }
+
+    /// Probability seed for the next transport start (each start advances it by one).
+    void setNextRunSeed(uint32_t seed) { run_seed_ = seed - 1U; }
+
+    /**
+     * @brief Take pattern edits from another thread through `source`
+     *
+     * Published snapshots are pulled into the engine's state on transport start
+     * and at the first step boundary of each update, so a batch lands whole on
+     * one step. Playback fields are published back to `source` after every
+     * update and render. `source` must outlive the engine; nullptr detaches it.
+     */
+    void setStateSource(StepSequencerStateExchange* source) {
+        static_assert(HAS_STATE_SOURCE_, "StepSequencerStateExchange holds 128-step states");
+        state_source_ = source;
+    }
+
+    /// Counters since construction or `resetStats()`; all zero unless built with `OC_NOTE_ENGINE_STATS`.
+    const StepSequencerStats& stats() const {
+#if OC_NOTE_ENGINE_STATS
+        return stats_;
+#else
+        static const StepSequencerStats disabled{};
+        return disabled;
+#endif
+    }
+
+    void resetStats() {
+#if OC_NOTE_ENGINE_STATS
+        stats_ = {};
+#endif
+    }
+
+    /// Host counter used to time `update()`; nullptr disables timing.
+    void setStatsCycleCounter(StatsCycleCounter counter) {
+#if OC_NOTE_ENGINE_STATS
+        cycle_counter_ = counter;
+#else
+        (void)counter;
+#endif
+    }
+
 private:
+    static constexpr bool HAS_STATE_SOURCE_ = std::is_same<State, StepSequencerRuntimeState>::value;
     static constexpr size_t CYCLE_MASK_CACHE_SIZE = 4;
+    // How many steps back a note can still be held: a +50% nudge plus a 200% gate, rounded up.
+    // Gates are clamped to MAX_GATE_PERCENT when compiled, so array writes cannot exceed it.
+    static constexpr uint32_t CHASE_STEPS_BEHIND =
+        (State::MAX_GATE_PERCENT + 50U + 99U) / 100U;
+    // Steps that can still have a NoteOn queued: the look-ahead plus one for a late nudge.
+    static constexpr uint32_t RESCHEDULE_WINDOW = 4;
+    // Triggered steps remembered for lock restores: the reschedule window and the one before it.
+    static constexpr size_t PLAYED_LOCK_HISTORY = RESCHEDULE_WINDOW + 1U;
+
+    struct StepNote_ {
+        uint32_t stepNumber = 0;
+        uint32_t onTick = 0;
+        uint32_t offTick = 0;
+        uint8_t channel = 0;
+        uint8_t note = 0;
+        uint8_t velocity = 0;
+        uint8_t tag = 0;
+        uint8_t stepIndex = 0;
+        uint8_t chordSize = 0;
+        uint16_t chordOffset = 0;
+    };
+
+    /// Parameter-lock lanes a triggered step set, in bit l for lane l.
+    struct PlayedLocks_ {
+        uint32_t stepNumber = 0;
+        uint8_t lanes = 0;
+    };
+
+    struct RenderBuffer_ {
+        SequencerEvent* out = nullptr;
+        size_t capacity = 0;
+        size_t count = 0;
+    };
+
+    /// Routes scheduler output back through `emitBatch_`.
+    struct EmitRouter_ {
+        size_t emitSequencerEvents(const SequencerEvent* events, size_t count) {
+            return engine_.emitBatch_(events, count);
+        }
+        BasicStepSequencerEngine& engine_;
+    };
 
     void start_();
     void stop_();
+    uint32_t updateTransport_(uint32_t tick, bool playing);
+    void recordUpdate_(uint32_t stepTicksAdvanced, uint32_t startCycles);
     void prepareFromTick_(uint32_t tick);
-    void advanceToTick_(uint32_t tick);
+    void jumpToTick_(uint32_t tick);
+    void refreshForTick_(uint32_t tick);
+    bool advanceToTick_(uint32_t tick);
+    uint32_t nextActiveStep_(uint32_t stepNumber, uint32_t endStep, uint8_t len);
+    void scheduleActiveSteps_(uint32_t endStep, uint16_t ticksPerStep, uint8_t len);
     void primeSchedule_();
-    void scheduleStep_(uint32_t stepNumber, uint8_t ticksPerStep);
+    void scheduleStep_(uint32_t stepNumber, uint16_t ticksPerStep);
+    void chaseNotes_(uint32_t tick);
+    bool resolveStepNote_(uint32_t stepNumber, uint16_t ticksPerStep, StepNote_& out);
+    bool resolveCompiledStep_(uint32_t stepNumber, uint16_t ticksPerStep, StepNote_& out);
+    void acceptStepEdits_();
+    void pullPublishedEdits_();
+    void publishPlayback_();
+    void applyStepEdits_();
+    void patchCycleMasks_(const StepMask& dirty, uint8_t len);
+    void queueNote_(const StepNote_& note);
+    uint8_t queueParameterLocks_(const StepNote_& note);
+    uint8_t lockedLanes_(uint8_t stepIndex) const;
+    uint8_t lanesLockedBefore_(uint32_t stepNumber) const;
+    void recordPlayedLocks_(uint32_t stepNumber, uint8_t lanes);
+    void forgetPlayedLocks_(uint32_t stepNumber);
+    void clearPlayedLocks_() { played_lock_count_ = 0; }
     void publishCycleMask_(uint32_t cycleIndex, uint8_t len);
     void clearCycleMaskCache_();
+    bool emit_(const SequencerEvent& event);
+    size_t emitBatch_(const SequencerEvent* events, size_t count);
     bool emitAllNotesOff_(uint32_t tick);
+    bool flushPendingAllNotesOff_();
     bool processDueEvents_(uint32_t tick);
 
-    uint8_t ticksPerStep_() const;
+    uint16_t ticksPerStep_() const;
     uint8_t patternLength_() const;
-    static uint8_t clampChannel_(uint8_t ch);
-    static int32_t nudgeTickOffset_(int8_t nudge, uint8_t ticksPerStep);
-    StepBitMask128 resolveCycleMask_(uint32_t cycleIndex, uint8_t len) const;
-    StepBitMask128 maskForCycle_(uint32_t cycleIndex, uint8_t len);
+    StepMask resolveCycleMask_(uint32_t cycleIndex, uint8_t len, const StepMask& candidates) const;
+    StepMask maskForCycle_(uint32_t cycleIndex, uint8_t len);
     bool shouldTriggerStep_(uint8_t stepIndex, uint32_t stepNumber, uint8_t len);
-    static uint32_t probabilityHash_(uint32_t runSeed, uint32_t cycleIndex, uint8_t stepIndex);
 
-    StepSequencerRuntimeState& state_;
-    ISequencerEventSink& event_sink_;
-    NoteScheduler scheduler_;
+    State& state_;
+    Sink& event_sink_;
+    Scheduler scheduler_;
+    BasicCompiledStepPattern<State> compiled_;
+    StepSequencerStateExchange* state_source_ = nullptr;
+    RenderBuffer_* render_ = nullptr;
+    // The last renderRange stopped early; the next call resumes rather than jumps.
+    bool render_incomplete_ = false;
+    // An AllNotesOff a full render buffer refused, written before anything else next time.
+    bool all_notes_off_pending_ = false;
+    uint32_t all_notes_off_pending_tick_ = 0;
 
     bool playing_ = false;
+    uint16_t ticks_per_quarter_ = oc::note::clock::PPQN;
     uint32_t last_tick_ = 0;
     uint32_t next_step_tick_ = 0;
     uint32_t next_scheduled_step_number_ = 0;
     uint32_t run_seed_ = 0;
     uint32_t published_cycle_index_ = UINT32_MAX;
     std::array<uint32_t, CYCLE_MASK_CACHE_SIZE> cached_cycle_indices_{};
-    std::array<StepBitMask128, CYCLE_MASK_CACHE_SIZE> cached_cycle_masks_{};
+    std::array<StepMask, CYCLE_MASK_CACHE_SIZE> cached_cycle_masks_{};
     size_t next_cycle_cache_slot_ = 0;
-    StepBitMask128 last_enabled_mask_{};
+    StepMask last_enabled_mask_{};
+    uint32_t seen_generation_ = 0;
+    // Last triggered steps in step order, oldest first.
+    std::array<PlayedLocks_, PLAYED_LOCK_HISTORY> played_locks_{};
+    size_t played_lock_count_ = 0;
+
+#if OC_NOTE_ENGINE_STATS
+    StepSequencerStats stats_{};
+    StatsCycleCounter cycle_counter_ = nullptr;
+#endif
 };
 
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::clearCycleMaskCache_() {
+    cached_cycle_indices_.fill(UINT32_MAX);
+    cached_cycle_masks_.fill({});
+    next_cycle_cache_slot_ = 0;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::reset() {
+    stop_();
+    scheduler_.clear();
+    last_tick_ = 0;
+    next_step_tick_ = 0;
+    next_scheduled_step_number_ = 0;
+    published_cycle_index_ = UINT32_MAX;
+    clearCycleMaskCache_();
+    clearPlayedLocks_();
+    compiled_.invalidate();
+    acceptStepEdits_();
+    render_incomplete_ = false;
+    all_notes_off_pending_ = false;
+    state_.probabilityCycleMask = {};
+    state_.probabilityCycleIndex = 0;
+    state_.probabilityCycleRevision += 1U;
+    publishPlayback_();
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::resyncToTick(uint32_t tick) {
+    playing_ = true;
+    jumpToTick_(tick);
+    publishPlayback_();
+}
+
+/// Silence everything queued and sounding, then play on from `tick` with its held notes re-sounded.
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::jumpToTick_(uint32_t tick) {
+    scheduler_.clear();
+    emitAllNotesOff_(tick);
+    compiled_.invalidate();
+    prepareFromTick_(tick);
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+uint8_t BasicStepSequencerEngine<Sink, Scheduler, StateType>::patternLength_() const {
+    const uint8_t len = state_.patternLength();
+    return len;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+uint16_t BasicStepSequencerEngine<Sink, Scheduler, StateType>::ticksPerStep_() const {
+    return ticksPerStep(
+        state_.stepsPerBeat, State::DEFAULT_STEPS_PER_BEAT, ticks_per_quarter_);
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+typename StateType::StepMask BasicStepSequencerEngine<Sink, Scheduler, StateType>::resolveCycleMask_(
+    uint32_t cycleIndex, uint8_t len, const StepMask& candidates) const {
+    if (len == 0) return {};
+
+    ProbabilityMaskInput input{};
+    input.probability = state_.probability.data();
+    input.gate = state_.gate.data();
+    input.enabledMask = toStepBitMask128(candidates);
+    input.length = len;
+    input.runSeed = run_seed_;
+    input.cycleIndex = cycleIndex;
+    return fromStepBitMask128<StepMask>(resolveProbabilityMask(input));
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+typename StateType::StepMask BasicStepSequencerEngine<Sink, Scheduler, StateType>::maskForCycle_(
+    uint32_t cycleIndex, uint8_t len) {
+    for (size_t i = 0; i < CYCLE_MASK_CACHE_SIZE; ++i) {
+        if (cached_cycle_indices_[i] == cycleIndex) {
+#if OC_NOTE_ENGINE_STATS
+            StepSequencerStats::bump(stats_.cycleMaskHits);
+#endif
+            return cached_cycle_masks_[i];
+        }
+    }
+
+#if OC_NOTE_ENGINE_STATS
+    StepSequencerStats::bump(stats_.cycleMaskMisses);
+#endif
+    const StepMask mask = resolveCycleMask_(cycleIndex, len, state_.enabledMask);
+    cached_cycle_indices_[next_cycle_cache_slot_] = cycleIndex;
+    cached_cycle_masks_[next_cycle_cache_slot_] = mask;
+    next_cycle_cache_slot_ = (next_cycle_cache_slot_ + 1U) % CYCLE_MASK_CACHE_SIZE;
+    return mask;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+bool BasicStepSequencerEngine<Sink, Scheduler, StateType>::shouldTriggerStep_(uint8_t stepIndex,
+                                                                              uint32_t stepNumber,
+                                                                              uint8_t len) {
+    if (len == 0 || stepIndex >= len) return false;
+    const uint32_t cycleIndex = stepNumber / static_cast<uint32_t>(len);
+    return maskForCycle_(cycleIndex, len).test(stepIndex);
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::publishCycleMask_(uint32_t cycleIndex,
+                                                                            uint8_t len) {
+    if (published_cycle_index_ == cycleIndex) return;
+
+    published_cycle_index_ = cycleIndex;
+    state_.probabilityCycleIndex = cycleIndex;
+    state_.probabilityCycleMask = maskForCycle_(cycleIndex, len);
+    state_.probabilityCycleRevision += 1U;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+RenderRangeResult BasicStepSequencerEngine<Sink, Scheduler, StateType>::renderBlock(
+    const AudioBlockTiming& block, SequencerEvent* out, uint32_t* sampleOffsets, size_t capacity) {
+    if (block.blockSize == 0 || !(block.sampleRate > 0.0f) || !(block.bpm > 0.0f)) return {};
+
+    const double samplesPerTick = static_cast<double>(block.sampleRate) * 60.0
+                                  / (static_cast<double>(block.bpm) * ticks_per_quarter_);
+    const double phase = static_cast<double>(block.startTickPhase);
+    const double endPosition = phase + static_cast<double>(block.blockSize) / samplesPerTick;
+
+    // First and one-past-last whole ticks inside [start, end), relative to startTick.
+    uint32_t firstTick = block.startTick + ((phase > 0.0) ? 1U : 0U);
+    const uint32_t endTick = block.startTick + static_cast<uint32_t>(std::ceil(endPosition));
+    if (playing_ && !render_incomplete_ && (firstTick == last_tick_ + 2U || firstTick == last_tick_)) {
+        firstTick = last_tick_ + 1U;
+    }
+
+    const RenderRangeResult result = renderRange(firstTick, endTick, out, capacity);
+    if (sampleOffsets == nullptr) return result;
+
+    const uint32_t lastSample = block.blockSize - 1U;
+    for (size_t i = 0; i < result.eventCount; ++i) {
+        const int32_t wholeTicks = static_cast<int32_t>(out[i].tick - block.startTick);
+        const double ticksIn = static_cast<double>(wholeTicks) - phase;
+        const double sample = std::floor(ticksIn * samplesPerTick + 0.5);
+        sampleOffsets[i] = (sample <= 0.0) ? 0U
+                           : (sample >= lastSample) ? lastSample
+                                                    : static_cast<uint32_t>(sample);
+    }
+    return result;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::start_() {
+    if constexpr (HAS_STATE_SOURCE_) {
+        if (state_source_ != nullptr) state_source_->pullInto(state_);
+    }
+    playing_ = true;
+    scheduler_.clear();
+    next_step_tick_ = 0;
+    last_tick_ = 0;
+    next_scheduled_step_number_ = 0;
+    ++run_seed_;
+    published_cycle_index_ = UINT32_MAX;
+    clearCycleMaskCache_();
+    clearPlayedLocks_();
+    compiled_.invalidate();
+    acceptStepEdits_();
+
+    const uint8_t len = patternLength_();
+    if (len > 0) {
+        publishCycleMask_(0, len);
+    }
+
+    primeSchedule_();
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::prepareFromTick_(uint32_t tick) {
+    const uint8_t len = patternLength_();
+    const uint16_t ticksPerStep = ticksPerStep_();
+
+    last_tick_ = tick;
+    published_cycle_index_ = UINT32_MAX;
+    clearCycleMaskCache_();
+    clearPlayedLocks_();
+    acceptStepEdits_();
+
+    if (len == 0) {
+        next_step_tick_ = 0;
+        next_scheduled_step_number_ = 0;
+        state_.playheadStep = -1;
+        state_.probabilityCycleMask = {};
+        state_.probabilityCycleIndex = 0;
+        state_.probabilityCycleRevision += 1U;
+        return;
+    }
+
+    const uint32_t stepNumber = tick / ticksPerStep;
+    const uint8_t stepIndex = static_cast<uint8_t>(stepNumber % len);
+    const uint32_t cycleIndex = stepNumber / static_cast<uint32_t>(len);
+
+    publishCycleMask_(cycleIndex, len);
+    state_.playheadStep = static_cast<int16_t>(stepIndex);
+
+    next_step_tick_ = (stepNumber + 1U) * static_cast<uint32_t>(ticksPerStep);
+    next_scheduled_step_number_ = stepNumber + 1U;
+    // Held notes first, so the steps queued ahead know which locks to restore.
+    chaseNotes_(tick);
+    while (next_scheduled_step_number_ < stepNumber + 4U) {
+        scheduleStep_(next_scheduled_step_number_, ticksPerStep);
+        ++next_scheduled_step_number_;
+    }
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::stop_() {
+    if (!playing_) return;
+    playing_ = false;
+    scheduler_.clear();
+    emitAllNotesOff_(last_tick_);
+    state_.playheadStep = -1;
+    published_cycle_index_ = UINT32_MAX;
+    clearCycleMaskCache_();
+    clearPlayedLocks_();
+    last_enabled_mask_ = state_.enabledMask;
+    state_.probabilityCycleMask = {};
+    state_.probabilityCycleIndex = 0;
+    state_.probabilityCycleRevision += 1U;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::update(uint32_t tick, bool playing) {
+#if OC_NOTE_ENGINE_STATS
+    const uint32_t startCycles = (cycle_counter_ != nullptr) ? cycle_counter_() : 0U;
+    recordUpdate_(updateTransport_(tick, playing), startCycles);
+#else
+    updateTransport_(tick, playing);
+#endif
+    publishPlayback_();
+}
+
+/// Returns how far the step clock moved, in ticks.
+template <typename Sink, typename Scheduler, typename StateType>
+uint32_t BasicStepSequencerEngine<Sink, Scheduler, StateType>::updateTransport_(uint32_t tick, bool playing) {
+    flushPendingAllNotesOff_();
+    render_incomplete_ = false;
+
+    if (playing && !playing_) {
+        start_();
+    } else if (!playing && playing_) {
+        stop_();
+        return 0;
+    }
+
+    if (!playing_) return 0;
+
+    refreshForTick_(tick);
+    const uint32_t stepTickBefore = next_step_tick_;
+    advanceToTick_(tick);
+    last_tick_ = tick;
+    return next_step_tick_ - stepTickBefore;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::recordUpdate_(uint32_t stepTicksAdvanced,
+                                                                         uint32_t startCycles) {
+#if OC_NOTE_ENGINE_STATS
+    const uint32_t steps = stepTicksAdvanced / ticksPerStep_();
+    StepSequencerStats::bump(stats_.updates);
+    StepSequencerStats::bump(stats_.stepsAdvanced, steps);
+    StepSequencerStats::raise(stats_.maxStepsPerUpdate, steps);
+
+    if (cycle_counter_ != nullptr) {
+        stats_.lastUpdateCycles = cycle_counter_() - startCycles;
+        StepSequencerStats::raise(stats_.maxUpdateCycles, stats_.lastUpdateCycles);
+    }
+#else
+    (void)stepTicksAdvanced;
+    (void)startCycles;
+#endif
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+RenderRangeResult BasicStepSequencerEngine<Sink, Scheduler, StateType>::renderRange(uint32_t fromTick,
+                                                                                    uint32_t toTick,
+                                                                                    SequencerEvent* out,
+                                                                                    size_t capacity) {
+    RenderRangeResult result{};
+    if (toTick <= fromTick) return result;
+
+    RenderBuffer_ buffer{out, (out != nullptr) ? capacity : 0U, 0};
+    render_ = &buffer;
+
+    if (flushPendingAllNotesOff_()) {
+        if (!playing_) {
+            start_();
+            if (fromTick > 0) {
+                scheduler_.clear();
+                prepareFromTick_(fromTick);
+            }
+        } else if (!render_incomplete_ && fromTick != last_tick_ + 1U) {
+            jumpToTick_(fromTick);
+        }
+
+        const uint32_t lastTick = toTick - 1U;
+        refreshForTick_(fromTick);
+        result.complete = advanceToTick_(lastTick) && !all_notes_off_pending_;
+        if (result.complete) {
+            last_tick_ = lastTick;
+        }
+    } else {
+        result.complete = false;
+    }
+    render_incomplete_ = !result.complete;
+
+    render_ = nullptr;
+    publishPlayback_();
+    result.eventCount = buffer.count;
+    return result;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::refreshForTick_(uint32_t tick) {
+    if (state_.generation != seen_generation_ || state_.enabledMask != last_enabled_mask_) {
+        applyStepEdits_();
+    }
+
+    const uint8_t len = patternLength_();
+
+    // Handle tick resets defensively; queued NoteOffs go with the schedule, so release everything.
+    if (tick < last_tick_) {
+        scheduler_.clear();
+        emitAllNotesOff_(tick);
+        next_step_tick_ = 0;
+        next_scheduled_step_number_ = 0;
+        published_cycle_index_ = UINT32_MAX;
+        clearCycleMaskCache_();
+        clearPlayedLocks_();
+        last_enabled_mask_ = state_.enabledMask;
+        if (len > 0) {
+            publishCycleMask_(0, len);
+        }
+        primeSchedule_();
+    }
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+bool BasicStepSequencerEngine<Sink, Scheduler, StateType>::advanceToTick_(uint32_t tick) {
+    if (next_step_tick_ <= tick) pullPublishedEdits_();
+
+    const uint8_t len = patternLength_();
+    if (len == 0) {
+        state_.playheadStep = -1;
+        return true;
+    }
+
+    const uint16_t ticksPerStep = ticksPerStep_();
+
+    while (next_step_tick_ <= tick) {
+        // A boundary schedules up to its step + 2, so the ones before the next active
+        // step's turn only move the playhead: jump to the last of them still due.
+        const uint32_t laterBoundaries = (tick - next_step_tick_) / ticksPerStep;
+        if (laterBoundaries > 0) {
+            const uint32_t firstStep = next_step_tick_ / ticksPerStep;
+            const uint32_t active =
+                nextActiveStep_(next_scheduled_step_number_, firstStep + laterBoundaries + 3U, len);
+            const uint32_t quiet = (active > firstStep + 2U) ? active - firstStep - 2U : 0U;
+            next_step_tick_ += std::min(quiet, laterBoundaries) * ticksPerStep;
+        }
+
+        if (!processDueEvents_(next_step_tick_)) return false;
+
+        const uint32_t stepNumber = next_step_tick_ / ticksPerStep;
+        const uint8_t stepIndex = static_cast<uint8_t>(stepNumber % len);
+        const uint32_t cycleIndex = stepNumber / static_cast<uint32_t>(len);
+
+        publishCycleMask_(cycleIndex, len);
+        state_.playheadStep = static_cast<int16_t>(stepIndex);
+
+        scheduleActiveSteps_(stepNumber + 3U, ticksPerStep, len);
+
+        next_step_tick_ += ticksPerStep;
+    }
+
+    return processDueEvents_(tick);
+}
+
+/// First step number in [stepNumber, endStep) whose cycle mask fires it; `endStep` when none.
+template <typename Sink, typename Scheduler, typename StateType>
+uint32_t BasicStepSequencerEngine<Sink, Scheduler, StateType>::nextActiveStep_(uint32_t stepNumber,
+                                                                               uint32_t endStep,
+                                                                               uint8_t len) {
+    if (!(state_.enabledMask & StepMask::prefixMask(len)).any()) return endStep;
+
+    while (stepNumber < endStep) {
+        const uint32_t cycleIndex = stepNumber / static_cast<uint32_t>(len);
+        const uint8_t from = static_cast<uint8_t>(stepNumber % len);
+        const uint8_t next = maskForCycle_(cycleIndex, len).findNextSet(from);
+        if (next < len) return std::min(cycleIndex * len + next, endStep);
+        stepNumber = (cycleIndex + 1U) * len;
+    }
+    return endStep;
+}
+
+/// Schedule the active steps in [next_scheduled_step_number_, endStep), skipping silent ones.
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::scheduleActiveSteps_(uint32_t endStep,
+                                                                                uint16_t ticksPerStep,
+                                                                                uint8_t len) {
+    while (next_scheduled_step_number_ < endStep) {
+        next_scheduled_step_number_ = nextActiveStep_(next_scheduled_step_number_, endStep, len);
+        if (next_scheduled_step_number_ == endStep) break;
+        scheduleStep_(next_scheduled_step_number_, ticksPerStep);
+        ++next_scheduled_step_number_;
+    }
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::primeSchedule_() {
+    const uint8_t len = patternLength_();
+    if (len == 0) return;
+
+    const uint16_t ticksPerStep = ticksPerStep_();
+    scheduleStep_(0, ticksPerStep);
+    scheduleStep_(1, ticksPerStep);
+    next_scheduled_step_number_ = 2;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::scheduleStep_(uint32_t stepNumber,
+                                                                         uint16_t ticksPerStep) {
+    StepNote_ note;
+    if (resolveStepNote_(stepNumber, ticksPerStep, note)) {
+        queueNote_(note);
+    }
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::chaseNotes_(uint32_t tick) {
+    if (patternLength_() == 0) return;
+
+    const uint16_t ticksPerStep = ticksPerStep_();
+    const uint32_t stepNumber = tick / ticksPerStep;
+    const uint32_t firstStep = (stepNumber > CHASE_STEPS_BEHIND) ? stepNumber - CHASE_STEPS_BEHIND : 0U;
+
+    // Steps after `stepNumber` are scheduled by prepareFromTick_ once this returns.
+    for (uint32_t step = firstStep; step <= stepNumber; ++step) {
+        StepNote_ note;
+        if (!resolveStepNote_(step, ticksPerStep, note)) continue;
+        if (note.offTick <= tick) {
+            // Released before the seek point, but the next step may still restore its locks.
+            recordPlayedLocks_(step, lockedLanes_(note.stepIndex));
+            continue;
+        }
+
+        // Held across the seek point: sound it now; a late (nudged) onset keeps its own tick.
+        if (note.onTick < tick) note.onTick = tick;
+        queueNote_(note);
+    }
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+bool BasicStepSequencerEngine<Sink, Scheduler, StateType>::resolveStepNote_(uint32_t stepNumber,
+                                                                            uint16_t ticksPerStep,
+                                                                            StepNote_& out) {
+    if (!compiled_.isCurrent(state_, ticksPerStep)) compiled_.compile(state_, ticksPerStep);
+
+    // Arrays written without the setters take effect here, when the step is scheduled.
+    // `generation` cannot see such writes, so this compares the step's four source
+    // fields; it recompiles only when one differs.
+    const uint8_t len = patternLength_();
+    if (len > 0) compiled_.refreshStep(state_, static_cast<uint8_t>(stepNumber % len));
+    return resolveCompiledStep_(stepNumber, ticksPerStep, out);
+}
+
+/// Resolve from the table as it stands, without recompiling; false when the table is empty.
+template <typename Sink, typename Scheduler, typename StateType>
+bool BasicStepSequencerEngine<Sink, Scheduler, StateType>::resolveCompiledStep_(uint32_t stepNumber,
+                                                                                uint16_t ticksPerStep,
+                                                                                StepNote_& out) {
+    const uint8_t len = patternLength_();
+    if (len == 0 || !compiled_.isValid()) return false;
+
+    const uint8_t stepIndex = static_cast<uint8_t>(stepNumber % len);
+    if (!shouldTriggerStep_(stepIndex, stepNumber, len)) return false;
+
+    const CompiledStep& step = compiled_.step(stepIndex);
+    out.stepNumber = stepNumber;
+    out.tag = static_cast<uint8_t>(stepIndex + 1U);
+    out.stepIndex = stepIndex;
+    out.channel = compiled_.channel();
+    out.note = step.note;
+    out.velocity = step.velocity;
+    out.chordSize = state_.chordSize(stepIndex);
+    out.chordOffset = (out.chordSize != 0) ? state_.chordOffset(stepIndex) : 0U;
+
+    const uint32_t stepStartTick = stepNumber * static_cast<uint32_t>(ticksPerStep);
+    out.onTick = (step.onOffset < 0 && stepStartTick < static_cast<uint32_t>(-step.onOffset))
+                     ? 0U
+                     : stepStartTick + static_cast<uint32_t>(static_cast<int32_t>(step.onOffset));
+    out.offTick = out.onTick + step.gateTicks;
+    return true;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::acceptStepEdits_() {
+    seen_generation_ = state_.generation;
+    state_.dirtySteps = {};
+    last_enabled_mask_ = state_.enabledMask;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::pullPublishedEdits_() {
+    if constexpr (HAS_STATE_SOURCE_) {
+        if (state_source_ != nullptr && state_source_->pullInto(state_)) applyStepEdits_();
+    }
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::publishPlayback_() {
+    if constexpr (HAS_STATE_SOURCE_) {
+        if (state_source_ != nullptr) state_source_->publishPlayback(state_);
+    }
+}
+
+/// Re-resolve and reschedule only the steps edited since the last update.
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::applyStepEdits_() {
+    const StepMask dirty = state_.dirtySteps | (state_.enabledMask ^ last_enabled_mask_);
+    acceptStepEdits_();
+
+    const uint8_t len = patternLength_();
+    if (len == 0) {
+        compiled_.invalidate();
+        clearCycleMaskCache_();
+        return;
+    }
+
+    const uint16_t ticksPerStep = ticksPerStep_();
+    const uint32_t endStep = next_scheduled_step_number_;
+    const uint32_t firstStep = (endStep > RESCHEDULE_WINDOW) ? endStep - RESCHEDULE_WINDOW : 0U;
+
+    // Whatever is queued was resolved from the tables as they stand now.
+    std::array<StepNote_, RESCHEDULE_WINDOW> before{};
+    std::array<bool, RESCHEDULE_WINDOW> triggered{};
+    for (uint32_t step = firstStep; step < endStep; ++step) {
+        const size_t slot = step - firstStep;
+        if (!dirty.test(static_cast<uint8_t>(step % len))) continue;
+        triggered[slot] = resolveCompiledStep_(step, ticksPerStep, before[slot]);
+    }
+
+    if (compiled_.isValid()) compiled_.recompileSteps(state_, dirty);
+    patchCycleMasks_(dirty, len);
+
+    for (uint32_t step = firstStep; step < endStep; ++step) {
+        const uint8_t stepIndex = static_cast<uint8_t>(step % len);
+        if (dirty.test(stepIndex)) scheduler_.cancelNotes(static_cast<uint8_t>(stepIndex + 1U), last_tick_);
+    }
+
+    for (uint32_t step = firstStep; step < endStep; ++step) {
+        const size_t slot = step - firstStep;
+        if (!dirty.test(static_cast<uint8_t>(step % len))) continue;
+        // Already sounded; its NoteOff was left in place.
+        if (triggered[slot] && before[slot].onTick <= last_tick_) continue;
+
+        forgetPlayedLocks_(step);
+        StepNote_ note;
+        if (!resolveStepNote_(step, ticksPerStep, note)) continue;
+        if (note.onTick <= last_tick_) {
+            // Pulled earlier than now: sound it late if it was still queued, else leave it.
+            if (!triggered[slot]) continue;
+            note.onTick = last_tick_ + 1U;
+            if (note.offTick <= note.onTick) continue;
+        }
+        queueNote_(note);
+    }
+}
+
+/// Patch the `dirty` bits of every cached cycle mask and republish the current one.
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::patchCycleMasks_(const StepMask& dirty,
+                                                                           uint8_t len) {
+    const StepMask candidates = state_.enabledMask & dirty;
+    for (size_t i = 0; i < CYCLE_MASK_CACHE_SIZE; ++i) {
+        if (cached_cycle_indices_[i] == UINT32_MAX) continue;
+        const StepMask fresh = resolveCycleMask_(cached_cycle_indices_[i], len, candidates);
+        cached_cycle_masks_[i] = (cached_cycle_masks_[i] & ~dirty) | fresh;
+    }
+
+    if (published_cycle_index_ != UINT32_MAX) {
+        const uint32_t cycleIndex = published_cycle_index_;
+        published_cycle_index_ = UINT32_MAX;
+        publishCycleMask_(cycleIndex, len);
+    }
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::queueNote_(const StepNote_& note) {
+    // The chord directory is public; one written inconsistently plays the step's own note only.
+    const bool chordFits = note.chordSize < State::MAX_CHORD_SIZE
+                           && note.chordOffset + note.chordSize <= State::CHORD_ARENA_SIZE;
+    ScheduleStatus status;
+    if (note.chordSize == 0 || !chordFits) {
+        status = scheduler_.scheduleNote(
+            note.onTick, note.offTick, note.channel, note.note, note.velocity, note.tag);
+    } else {
+        std::array<uint8_t, State::MAX_CHORD_SIZE> notes;
+        std::array<uint8_t, State::MAX_CHORD_SIZE> velocities;
+        notes[0] = note.note;
+        velocities[0] = note.velocity;
+        std::copy_n(&state_.chordNote[note.chordOffset], note.chordSize, notes.begin() + 1);
+        std::copy_n(&state_.chordVelocity[note.chordOffset], note.chordSize, velocities.begin() + 1);
+        status = scheduler_.scheduleChord(note.onTick,
+                                          note.offTick,
+                                          note.channel,
+                                          notes.data(),
+                                          velocities.data(),
+                                          note.chordSize + 1U,
+                                          note.tag);
+    }
+#if OC_NOTE_ENGINE_STATS
+    if (status != ScheduleStatus::Queued) StepSequencerStats::bump(stats_.schedulerOverflows);
+    StepSequencerStats::raise(stats_.schedulerPeak, static_cast<uint32_t>(scheduler_.size()));
+#endif
+    if (status == ScheduleStatus::Rejected) {
+        emitAllNotesOff_(note.onTick);
+        scheduler_.clear();
+        return;
+    }
+    if (status == ScheduleStatus::Dropped) return;
+
+    const uint8_t locked = (state_.parameterLocks.activeLanes != 0) ? queueParameterLocks_(note) : 0U;
+    recordPlayedLocks_(note.stepNumber, locked);
+}
+
+/// CCs for the step's locks, plus restores for lanes the previous triggered step locked.
+/// Returns the lanes this step locks; 0 when a rejected CC cleared the queue.
+template <typename Sink, typename Scheduler, typename StateType>
+uint8_t BasicStepSequencerEngine<Sink, Scheduler, StateType>::queueParameterLocks_(const StepNote_& note) {
+    const StepParameterLocks& locks = state_.parameterLocks;
+    const uint8_t locked = lockedLanes_(note.stepIndex);
+    const uint8_t restored = static_cast<uint8_t>(lanesLockedBefore_(note.stepNumber) & ~locked);
+
+    for (uint8_t lane = 0; lane < StepParameterLocks::MAX_LANES; ++lane) {
+        const uint8_t bit = static_cast<uint8_t>(1U << lane);
+        uint8_t value;
+        if ((locked & bit) != 0) {
+            value = locks.value(lane, note.stepIndex);
+        } else if ((restored & bit) != 0 && (locks.activeLanes & bit) != 0
+                   && locks.restoreValue[lane] != StepParameterLocks::NO_RESTORE) {
+            value = locks.restoreValue[lane];
+        } else {
+            continue;
+        }
+
+        const ScheduleStatus status = scheduler_.scheduleControlChange(
+            note.onTick, note.channel, locks.controller[lane], value, note.tag);
+#if OC_NOTE_ENGINE_STATS
+        if (status != ScheduleStatus::Queued) StepSequencerStats::bump(stats_.schedulerOverflows);
+        StepSequencerStats::raise(stats_.schedulerPeak, static_cast<uint32_t>(scheduler_.size()));
+#endif
+        if (status == ScheduleStatus::Rejected) {
+            emitAllNotesOff_(note.onTick);
+            scheduler_.clear();
+            return 0;
+        }
+        // The queue is full; later lanes would be dropped too.
+        if (status == ScheduleStatus::Dropped) break;
+    }
+    return locked;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+uint8_t BasicStepSequencerEngine<Sink, Scheduler, StateType>::lockedLanes_(uint8_t stepIndex) const {
+    const StepParameterLocks& locks = state_.parameterLocks;
+    uint8_t lanes = 0;
+    for (uint8_t lane = 0; lane < StepParameterLocks::MAX_LANES; ++lane) {
+        if ((locks.activeLanes & (1U << lane)) != 0 && locks.present[lane].test(stepIndex)) {
+            lanes = static_cast<uint8_t>(lanes | (1U << lane));
+        }
+    }
+    return lanes;
+}
+
+/// Lanes locked by the last triggered step before `stepNumber`; 0 when none is remembered.
+template <typename Sink, typename Scheduler, typename StateType>
+uint8_t BasicStepSequencerEngine<Sink, Scheduler, StateType>::lanesLockedBefore_(uint32_t stepNumber) const {
+    for (size_t i = played_lock_count_; i > 0; --i) {
+        if (played_locks_[i - 1U].stepNumber < stepNumber) return played_locks_[i - 1U].lanes;
+    }
+    return 0;
+}
+
+/// Remember that `stepNumber` triggered; steps arrive in order except when rescheduled or chased.
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::recordPlayedLocks_(uint32_t stepNumber,
+                                                                             uint8_t lanes) {
+    size_t at = played_lock_count_;
+    while (at > 0 && played_locks_[at - 1U].stepNumber >= stepNumber) --at;
+    if (at < played_lock_count_ && played_locks_[at].stepNumber == stepNumber) {
+        played_locks_[at].lanes = lanes;
+        return;
+    }
+
+    if (played_lock_count_ == PLAYED_LOCK_HISTORY) {
+        if (at == 0) return;  // older than everything kept
+        std::copy(played_locks_.begin() + 1, played_locks_.end(), played_locks_.begin());
+        --played_lock_count_;
+        --at;
+    }
+    std::copy_backward(played_locks_.begin() + static_cast<ptrdiff_t>(at),
+                       played_locks_.begin() + static_cast<ptrdiff_t>(played_lock_count_),
+                       played_locks_.begin() + static_cast<ptrdiff_t>(played_lock_count_ + 1U));
+    played_locks_[at] = {stepNumber, lanes};
+    ++played_lock_count_;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+void BasicStepSequencerEngine<Sink, Scheduler, StateType>::forgetPlayedLocks_(uint32_t stepNumber) {
+    for (size_t i = 0; i < played_lock_count_; ++i) {
+        if (played_locks_[i].stepNumber != stepNumber) continue;
+        std::copy(played_locks_.begin() + static_cast<ptrdiff_t>(i + 1U),
+                  played_locks_.begin() + static_cast<ptrdiff_t>(played_lock_count_),
+                  played_locks_.begin() + static_cast<ptrdiff_t>(i));
+        --played_lock_count_;
+        return;
+    }
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+bool BasicStepSequencerEngine<Sink, Scheduler, StateType>::emit_(const SequencerEvent& event) {
+    if (render_ == nullptr) {
+        return event_sink_.emitSequencerEvent(event);
+    }
+
+    if (render_->count >= render_->capacity) return false;
+    render_->out[render_->count++] = event;
+    return true;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+size_t BasicStepSequencerEngine<Sink, Scheduler, StateType>::emitBatch_(const SequencerEvent* events,
+                                                                        size_t count) {
+    if (render_ == nullptr) {
+        return event_sink_.emitSequencerEvents(events, count);
+    }
+
+    const size_t accepted = std::min(count, render_->capacity - render_->count);
+    std::copy(events, events + accepted, render_->out + render_->count);
+    render_->count += accepted;
+    return accepted;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+bool BasicStepSequencerEngine<Sink, Scheduler, StateType>::emitAllNotesOff_(uint32_t tick) {
+    SequencerEvent event{};
+    event.tick = tick;
+    event.type = SequencerEventType::AllNotesOff;
+    if (emit_(event)) return true;
+
+    // Only a full render buffer gets here with a rendering call; keep the earliest for the next one.
+    if (render_ != nullptr && !all_notes_off_pending_) {
+        all_notes_off_pending_ = true;
+        all_notes_off_pending_tick_ = tick;
+    }
+    return false;
+}
+
+/// Returns false when a pending AllNotesOff still does not fit.
+template <typename Sink, typename Scheduler, typename StateType>
+bool BasicStepSequencerEngine<Sink, Scheduler, StateType>::flushPendingAllNotesOff_() {
+    if (!all_notes_off_pending_) return true;
+    all_notes_off_pending_ = false;
+    return emitAllNotesOff_(all_notes_off_pending_tick_) || render_ == nullptr;
+}
+
+template <typename Sink, typename Scheduler, typename StateType>
+bool BasicStepSequencerEngine<Sink, Scheduler, StateType>::processDueEvents_(uint32_t tick) {
+    EmitRouter_ router{*this};
+    if (scheduler_.processBatchUntil(tick, router)) {
+        return true;
+    }
+
+    // A full render buffer is not a sink failure: keep the queue and resume later.
+    if (render_ != nullptr && render_->count >= render_->capacity) {
+        return false;
+    }
+
+#if OC_NOTE_ENGINE_STATS
+    StepSequencerStats::bump(stats_.sinkFailures);
+#endif
+    emitAllNotesOff_(tick);
+    scheduler_.clear();
+    return true;
+}
+
+using StepSequencerEngine = BasicStepSequencerEngine<ISequencerEventSink>;
+
+extern template class BasicStepSequencerEngine<ISequencerEventSink>;
+
 }  // namespace oc::note::sequencer
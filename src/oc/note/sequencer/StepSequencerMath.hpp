@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+#include <oc/note/clock/ClockConstants.hpp>
+
+namespace oc::note::sequencer {
+
+/// Shared step timing / probability helpers used by the sequencer engines.
+
+inline uint8_t clampMidiChannel(uint8_t ch) {
+    return (ch > 15) ? 15 : ch;
+}
+
+inline uint16_t ticksPerStep(uint8_t stepsPerBeat,
+                             uint8_t defaultStepsPerBeat,
+                             uint16_t ticksPerQuarter = oc::note::clock::PPQN) {
+    uint16_t spb = stepsPerBeat;
+    if (spb == 0) spb = defaultStepsPerBeat;
+    if (spb > ticksPerQuarter) spb = ticksPerQuarter;
+
+    uint16_t tps = static_cast<uint16_t>(ticksPerQuarter / spb);
+    if (tps == 0) tps = 1;
+    return tps;
+}
+
+inline int32_t nudgeTickOffset(int8_t nudge, uint16_t ticksPerStep) {
+    const int32_t clamped = (nudge < -50) ? -50 : ((nudge > 50) ? 50 : nudge);
+    const int32_t scaled = clamped * static_cast<int32_t>(ticksPerStep);
+
+    if (scaled >= 0) {
+        return (scaled + 50) / 100;
+    }
+
+    return -(((-scaled) + 50) / 100);
+}
+
+inline uint32_t gateTicks(uint16_t gatePercent, uint16_t ticksPerStep) {
+    const uint32_t ticks = (static_cast<uint32_t>(gatePercent) * ticksPerStep) / 100U;
+    return (ticks == 0) ? 1U : ticks;
+}
+
+inline uint32_t probabilityHash(uint32_t runSeed, uint32_t cycleIndex, uint8_t stepIndex) {
+    uint32_t x = runSeed * 747796405u;
+    x ^= cycleIndex * 2891336453u;
+    x ^= static_cast<uint32_t>(stepIndex) * 277803737u;
+    x ^= 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 2246822519u;
+    x ^= x >> 13;
+    x *= 3266489917u;
+    x ^= x >> 16;
+    return x;
+}
+
+}  // namespace oc::note::sequencer
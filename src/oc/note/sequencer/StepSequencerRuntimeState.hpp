@@ -2,13 +2,26 @@
 
 #include <array>
 #include <cstdint>
+#include <cstring>
 
-#include "StepBitMask128.hpp"
+#include "SequencerConfig.hpp"
+#include "StepParameterLocks.hpp"
 
 namespace oc::note::sequencer {
 
-struct StepSequencerRuntimeState {
-    static constexpr uint8_t MAX_STEPS = 128;
+/**
+ * @brief Engine-side state of one mono track
+ *
+ * `Config::MAX_STEPS` sizes the step arrays, the chord arena and the step
+ * masks, so a 16-step track keeps 16 steps and one-word masks. Parameter
+ * locks keep their fixed 128-step layout. `StepSequencerRuntimeState` is the
+ * 128-step form the state exchange, trace and bounce modules take.
+ */
+template <typename Config = DefaultSequencerConfig>
+struct BasicStepSequencerRuntimeState {
+    using StepMask = typename Config::StepMask;
+
+    static constexpr uint8_t MAX_STEPS = Config::MAX_STEPS;
     static constexpr uint16_t MAX_GATE_PERCENT = 200;
 
     static constexpr uint8_t DEFAULT_LENGTH = 8;
@@ -19,28 +32,55 @@ struct StepSequencerRuntimeState {
     static constexpr uint16_t DEFAULT_GATE_PERCENT = 100;
     static constexpr uint8_t DEFAULT_PROBABILITY = 100;
 
+    /// Notes one step can sound, its own `note[i]` included.
+    static constexpr uint8_t MAX_CHORD_SIZE = 8;
+    /// Extra chord notes shared by all steps.
+    static constexpr uint16_t CHORD_ARENA_SIZE = 2U * MAX_STEPS;
+    static_assert(CHORD_ARENA_SIZE <= 256U, "chordStart holds arena offsets in one byte");
+
     uint8_t length = DEFAULT_LENGTH;
     int16_t playheadStep = -1;
     uint8_t stepsPerBeat = DEFAULT_STEPS_PER_BEAT;
     uint8_t midiChannel = DEFAULT_MIDI_CHANNEL_0BASED;
-    StepBitMask128 enabledMask{};
+    StepMask enabledMask{};
 
     uint32_t probabilityCycleRevision = 0;
-    StepBitMask128 probabilityCycleMask{};
+    StepMask probabilityCycleMask{};
     uint32_t probabilityCycleIndex = 0;
 
+    /// Bumped by every step edit made through the setters below.
+    uint32_t generation = 0;
+    /// Steps edited since a playing engine last looked; the engine clears it.
+    StepMask dirtySteps{};
+
     std::array<uint8_t, MAX_STEPS> note{};
     std::array<uint8_t, MAX_STEPS> velocity{};
     std::array<uint16_t, MAX_STEPS> gate{};
     std::array<int8_t, MAX_STEPS> nudge{};
     std::array<uint8_t, MAX_STEPS> probability{};
 
-    StepSequencerRuntimeState() { reset(); }
+    // Extra chord notes, packed in step order: step i owns
+    // chordNote/chordVelocity[chordOffset(i) .. chordOffset(i) + chordSize(i)).
+    // Only steps in `chordSteps` have a directory entry, at chordStart[chordSteps.rank(i)];
+    // a chord ends where the next one starts, or at `chordArenaUsed`.
+    StepMask chordSteps{};
+    std::array<uint8_t, MAX_STEPS> chordStart{};
+    std::array<uint8_t, CHORD_ARENA_SIZE> chordNote{};
+    std::array<uint8_t, CHORD_ARENA_SIZE> chordVelocity{};
+    uint16_t chordArenaUsed = 0;
+
+    StepParameterLocks parameterLocks{};
+
+    BasicStepSequencerRuntimeState() { reset(); }
 
     static uint8_t clampProbability(uint8_t value) {
         return (value > 100U) ? 100U : value;
     }
 
+    static uint16_t clampGatePercent(uint16_t value) {
+        return (value > MAX_GATE_PERCENT) ? MAX_GATE_PERCENT : value;
+    }
+
     void reset() {
         length = DEFAULT_LENGTH;
         playheadStep = -1;
@@ -58,11 +98,138 @@ struct StepSequencerRuntimeState {
             nudge[i] = 0;
             probability[i] = DEFAULT_PROBABILITY;
         }
+        chordSteps = {};
+        chordStart.fill(0);
+        chordArenaUsed = 0;
+        parameterLocks.clear();
+        markStepDataChanged();
+    }
+
+    // Edits made through these reach a playing engine at its next update, which
+    // re-resolves and reschedules only the steps marked dirty.
+    void setNote(uint8_t step, uint8_t value) { setStepField_(note, step, value); }
+    void setVelocity(uint8_t step, uint8_t value) { setStepField_(velocity, step, value); }
+    void setGate(uint8_t step, uint16_t value) { setStepField_(gate, step, clampGatePercent(value)); }
+    void setNudge(uint8_t step, int8_t value) { setStepField_(nudge, step, value); }
+    void setProbability(uint8_t step, uint8_t value) {
+        setStepField_(probability, step, clampProbability(value));
+    }
+
+    void setStepEnabled(uint8_t step, bool enabled) {
+        if (step >= MAX_STEPS || enabledMask.test(step) == enabled) return;
+        enabledMask.setBit(step, enabled);
+        markStepDirty(step);
+    }
+
+    /**
+     * @brief Replace the extra notes `step` sounds with its own note
+     *
+     * `count` may be 0 to make the step a single note again. Returns false,
+     * leaving the step unchanged, when `count` exceeds `MAX_CHORD_SIZE - 1` or
+     * the arena has no room. Costs O(arena + steps); meant for edit time.
+     */
+    bool setChord(uint8_t step, const uint8_t* notes, const uint8_t* velocities, uint8_t count) {
+        if (step >= MAX_STEPS || count >= MAX_CHORD_SIZE) return false;
+
+        const uint16_t offset = chordOffset(step);
+        uint8_t* const stepNotes = chordNote.data() + offset;
+        uint8_t* const stepVelocities = chordVelocity.data() + offset;
+        const uint8_t previous = chordSize(step);
+        if (count == previous
+            && (count == 0
+                || (std::memcmp(stepNotes, notes, count) == 0
+                    && std::memcmp(stepVelocities, velocities, count) == 0))) {
+            return true;
+        }
+        if (chordArenaUsed - previous + count > CHORD_ARENA_SIZE) return false;
+
+        const size_t tail = chordArenaUsed - offset - previous;
+        std::memmove(stepNotes + count, stepNotes + previous, tail);
+        std::memmove(stepVelocities + count, stepVelocities + previous, tail);
+        if (count > 0) {
+            std::memcpy(stepNotes, notes, count);
+            std::memcpy(stepVelocities, velocities, count);
+        }
+
+        const uint8_t rank = chordSteps.rank(step);
+        const uint8_t entries = chordSteps.count();
+        if (previous == 0) {
+            for (uint8_t i = entries; i > rank; --i) {
+                chordStart[i] = static_cast<uint8_t>(chordStart[i - 1U] + count);
+            }
+            chordStart[rank] = static_cast<uint8_t>(offset);
+            chordSteps.setBit(step);
+        } else if (count == 0) {
+            for (uint8_t i = rank; i + 1U < entries; ++i) {
+                chordStart[i] = static_cast<uint8_t>(chordStart[i + 1U] - previous);
+            }
+            chordSteps.setBit(step, false);
+        } else {
+            for (uint8_t i = static_cast<uint8_t>(rank + 1U); i < entries; ++i) {
+                chordStart[i] = static_cast<uint8_t>(chordStart[i] - previous + count);
+            }
+        }
+        chordArenaUsed = static_cast<uint16_t>(chordArenaUsed - previous + count);
+        markStepDirty(step);
+        return true;
+    }
+
+    /// Extra notes `step` sounds with its own note.
+    uint8_t chordSize(uint8_t step) const {
+        if (!chordSteps.test(step)) return 0;
+        const uint8_t rank = chordSteps.rank(step);
+        const uint16_t end = (rank + 1U < chordSteps.count()) ? chordStart[rank + 1U] : chordArenaUsed;
+        return static_cast<uint8_t>(end - chordStart[rank]);
+    }
+
+    /// Where `step`'s extra notes start in the arena (or would be inserted).
+    uint16_t chordOffset(uint8_t step) const {
+        const uint8_t rank = chordSteps.rank(step);
+        return (rank < chordSteps.count()) ? chordStart[rank] : chordArenaUsed;
+    }
+
+    void clearChord(uint8_t step) { setChord(step, nullptr, nullptr, 0); }
+
+    /// Send CC `cc` = `value` when `step` plays; false when lanes or lock slots run out.
+    bool setParameterLock(uint8_t step, uint8_t cc, uint8_t value) {
+        if (step >= MAX_STEPS) return false;
+        const uint8_t lane = parameterLocks.laneOf(cc);
+        if (parameterLocks.isLocked(lane, step) && parameterLocks.value(lane, step) == value) return true;
+        if (!parameterLocks.set(step, cc, value)) return false;
+        markStepDirty(step);
+        return true;
+    }
+
+    void clearParameterLock(uint8_t step, uint8_t cc) {
+        if (parameterLocks.remove(step, cc)) markStepDirty(step);
+    }
+
+    /// Call after writing one step's arrays directly.
+    void markStepDirty(uint8_t step) {
+        if (step >= MAX_STEPS) return;
+        dirtySteps.setBit(step);
+        generation += 1U;
+    }
+
+    /// Call after writing step arrays directly without tracking which steps changed.
+    void markStepDataChanged() {
+        dirtySteps = StepMask::prefixMask(MAX_STEPS);
+        generation += 1U;
     }
 
     uint8_t patternLength() const {
         return (length > MAX_STEPS) ? MAX_STEPS : length;
     }
+
+private:
+    template <typename T>
+    void setStepField_(std::array<T, MAX_STEPS>& field, uint8_t step, T value) {
+        if (step >= MAX_STEPS || field[step] == value) return;
+        field[step] = value;
+        markStepDirty(step);
+    }
 };
 
+using StepSequencerRuntimeState = BasicStepSequencerRuntimeState<>;
+
 }  // namespace oc::note::sequencer
@@ -3,9 +3,10 @@
 #include <array>
 #include <cstdint>
 
+#include <config/PlatformCompat.hpp>
 #include <oc/state/Signal.hpp>
 
-#include "StepBitMask128.hpp"
+#include "SequencerConfig.hpp"
 
 namespace oc::note::sequencer {
 
@@ -18,9 +19,15 @@ using oc::state::Signal;
  * - UI-friendly (reactive signals for key UI updates)
  * - Engine-friendly (arrays + masks for fast access)
  * - Settings-ready (explicit defaults, no magic numbers)
+ *
+ * `Config::MAX_STEPS` sizes the step arrays and masks, as in
+ * `BasicStepSequencerRuntimeState`.
  */
-struct StepSequencerState {
-    static constexpr uint8_t MAX_STEPS = 128;
+template <typename Config = DefaultSequencerConfig>
+struct BasicStepSequencerState {
+    using StepMask = typename Config::StepMask;
+
+    static constexpr uint8_t MAX_STEPS = Config::MAX_STEPS;
     static constexpr uint16_t MAX_GATE_PERCENT = 200;
 
     // Defaults
@@ -32,7 +39,7 @@ struct StepSequencerState {
     static constexpr uint16_t DEFAULT_GATE_PERCENT = 100;
     static constexpr uint8_t DEFAULT_PROBABILITY = 100;
 
-    StepSequencerState();
+    BasicStepSequencerState();
 
     // Playback / transport
     Signal<uint8_t, 8> length{DEFAULT_LENGTH};
@@ -41,11 +48,11 @@ struct StepSequencerState {
     Signal<uint8_t, 6> midiChannel{DEFAULT_MIDI_CHANNEL_0BASED};
 
     // Step enable flags
-    Signal<StepBitMask128> enabledMask{};
+    Signal<StepMask> enabledMask{};
 
     // Runtime probability resolution for the currently active cycle.
     Signal<uint32_t> probabilityCycleRevision{0};
-    StepBitMask128 probabilityCycleMask{};
+    StepMask probabilityCycleMask{};
     uint32_t probabilityCycleIndex = 0;
 
     // Step properties
@@ -73,17 +80,58 @@ struct StepSequencerState {
 
     void setEnabled(uint8_t step, bool enabled) {
         if (step >= MAX_STEPS) return;
-        StepBitMask128 m = enabledMask.get();
+        StepMask m = enabledMask.get();
         m.setBit(step, enabled);
         enabledMask.set(m);
     }
 
     void toggle(uint8_t step) {
         if (step >= MAX_STEPS) return;
-        StepBitMask128 m = enabledMask.get();
+        StepMask m = enabledMask.get();
         m.toggleBit(step);
         enabledMask.set(m);
     }
 };
 
+template <typename Config>
+FLASHMEM BasicStepSequencerState<Config>::BasicStepSequencerState()
+    : length{DEFAULT_LENGTH},
+      playheadStep{-1},
+      stepsPerBeat{DEFAULT_STEPS_PER_BEAT},
+      midiChannel{DEFAULT_MIDI_CHANNEL_0BASED},
+      enabledMask{},
+      probabilityCycleRevision{0} {
+    length.setDebugLabel("note.stepSequencer.length");
+    playheadStep.setDebugLabel("note.stepSequencer.playheadStep");
+    stepsPerBeat.setDebugLabel("note.stepSequencer.stepsPerBeat");
+    midiChannel.setDebugLabel("note.stepSequencer.midiChannel");
+    enabledMask.setDebugLabel("note.stepSequencer.enabledMask");
+    probabilityCycleRevision.setDebugLabel("note.stepSequencer.probabilityCycleRevision");
+    reset();
+}
+
+template <typename Config>
+FLASHMEM void BasicStepSequencerState<Config>::reset() {
+    length.set(DEFAULT_LENGTH);
+    playheadStep.set(-1);
+    stepsPerBeat.set(DEFAULT_STEPS_PER_BEAT);
+    midiChannel.set(DEFAULT_MIDI_CHANNEL_0BASED);
+    enabledMask.set({});
+    probabilityCycleMask = {};
+    probabilityCycleIndex = 0;
+    probabilityCycleRevision.set(0);
+
+    for (uint8_t i = 0; i < MAX_STEPS; ++i) {
+        note[i] = DEFAULT_NOTE;
+        velocity[i] = DEFAULT_VELOCITY;
+        gate[i] = DEFAULT_GATE_PERCENT;
+        nudge[i] = 0;
+        probability[i] = DEFAULT_PROBABILITY;
+    }
+}
+
+using StepSequencerState = BasicStepSequencerState<>;
+
+extern template struct BasicStepSequencerState<DefaultSequencerConfig>;
+
 }  // namespace oc::note::sequencer
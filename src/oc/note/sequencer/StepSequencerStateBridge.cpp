@@ -0,0 +1,7 @@
+#include "StepSequencerStateBridge.hpp"
+
+namespace oc::note::sequencer {
+
+template class BasicStepSequencerStateBridge<DefaultSequencerConfig>;
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "StepSequencerRuntimeState.hpp"
+#include "StepSequencerState.hpp"
+#include "StepSequencerStateExchange.hpp"
+
+namespace oc::note::sequencer {
+
+/**
+ * @brief Per-frame sync between the UI state and the engine's runtime state
+ *
+ * Step edits go through the setters here (or are reported with
+ * `markStepDirty`), so `pushEdits()` copies only what changed. Signal fields
+ * (length, steps-per-beat, channel, enabled mask) are compared against the
+ * runtime values at push time. However many edits land in one UI frame,
+ * one `pushEdits()` delivers them as a single batch.
+ *
+ * `pullPlayback()` goes the other way: playhead and probability-cycle
+ * fields are written to the UI, and each Signal is set only when its value
+ * moved. Call both once per UI frame rather than per engine tick.
+ *
+ * A single-threaded host pushes straight into the engine's state and pulls
+ * playback from it. A threaded host pushes into
+ * `StepSequencerStateExchange::edit()`, then calls `publish()`, and pulls
+ * playback from `StepSequencerStateExchange::playback()`: the engine's
+ * runtime state must not be read from the UI thread while it plays.
+ * The exchange carries 128-step states, so a smaller `Config` pushes into the
+ * engine's state directly.
+ */
+template <typename Config = DefaultSequencerConfig>
+class BasicStepSequencerStateBridge {
+public:
+    using UiState = BasicStepSequencerState<Config>;
+    using RuntimeState = BasicStepSequencerRuntimeState<Config>;
+    using StepMask = typename Config::StepMask;
+
+    explicit BasicStepSequencerStateBridge(UiState& ui)
+        : ui_(ui) {}
+
+    void setNote(uint8_t step, uint8_t value) { setStepField_(ui_.note, step, value); }
+    void setVelocity(uint8_t step, uint8_t value) { setStepField_(ui_.velocity, step, value); }
+
+    void setGate(uint8_t step, uint16_t value) {
+        constexpr uint16_t maxGate = UiState::MAX_GATE_PERCENT;
+        setStepField_(ui_.gate, step, (value > maxGate) ? maxGate : value);
+    }
+
+    void setNudge(uint8_t step, int8_t value) { setStepField_(ui_.nudge, step, value); }
+
+    void setProbability(uint8_t step, uint8_t value) {
+        setStepField_(ui_.probability, step, UiState::clampProbability(value));
+    }
+
+    /// Call after writing one step of the UI arrays directly.
+    void markStepDirty(uint8_t step) {
+        if (step < UiState::MAX_STEPS) dirty_steps_.setBit(step);
+    }
+
+    /// Call after bulk changes to the UI arrays (e.g. loading a preset).
+    void markAllStepsDirty() {
+        dirty_steps_ = StepMask::prefixMask(UiState::MAX_STEPS);
+    }
+
+    /// Push everything edited since the last push into `runtime`; returns false when nothing changed.
+    bool pushEdits(RuntimeState& runtime);
+
+    /// Mirror playback fields from `engineState` into the UI Signals; call on the engine's thread.
+    void pullPlayback(const RuntimeState& engineState);
+
+    /// Mirror playback fields published through a `StepSequencerStateExchange`.
+    void pullPlayback(const StepSequencerPlayback& playback);
+
+private:
+    template <typename T>
+    void setStepField_(std::array<T, UiState::MAX_STEPS>& field, uint8_t step, T value) {
+        if (step >= UiState::MAX_STEPS) return;
+        field[step] = value;
+        dirty_steps_.setBit(step);
+    }
+
+    UiState& ui_;
+    StepMask dirty_steps_{};
+};
+
+template <typename Config>
+bool BasicStepSequencerStateBridge<Config>::pushEdits(RuntimeState& runtime) {
+    const uint32_t generation = runtime.generation;
+    bool scalarsChanged = false;
+
+    if (runtime.length != ui_.length.get()) {
+        runtime.length = ui_.length.get();
+        scalarsChanged = true;
+    }
+    if (runtime.stepsPerBeat != ui_.stepsPerBeat.get()) {
+        runtime.stepsPerBeat = ui_.stepsPerBeat.get();
+        scalarsChanged = true;
+    }
+    if (runtime.midiChannel != ui_.midiChannel.get()) {
+        runtime.midiChannel = ui_.midiChannel.get();
+        scalarsChanged = true;
+    }
+
+    const StepMask enabled = ui_.enabledMask.get();
+    const StepMask flipped = enabled ^ runtime.enabledMask;
+    const StepMask dirty = dirty_steps_;
+    dirty_steps_ = {};
+
+    for (uint8_t step = flipped.findNextSet(0); step < UiState::MAX_STEPS;
+         step = flipped.findNextSet(static_cast<uint8_t>(step + 1U))) {
+        runtime.setStepEnabled(step, enabled.test(step));
+    }
+
+    // Runtime setters ignore unchanged values: a touched but unchanged step is not marked dirty.
+    for (uint8_t step = dirty.findNextSet(0); step < UiState::MAX_STEPS;
+         step = dirty.findNextSet(static_cast<uint8_t>(step + 1U))) {
+        runtime.setNote(step, ui_.note[step]);
+        runtime.setVelocity(step, ui_.velocity[step]);
+        runtime.setGate(step, ui_.gate[step]);
+        runtime.setNudge(step, ui_.nudge[step]);
+        runtime.setProbability(step, ui_.probability[step]);
+    }
+
+    return scalarsChanged || runtime.generation != generation;
+}
+
+template <typename Config>
+void BasicStepSequencerStateBridge<Config>::pullPlayback(const RuntimeState& engineState) {
+    StepSequencerPlayback playback;
+    playback.playheadStep = engineState.playheadStep;
+    playback.probabilityCycleIndex = engineState.probabilityCycleIndex;
+    playback.probabilityCycleMask = toStepBitMask128(engineState.probabilityCycleMask);
+    playback.probabilityCycleRevision = engineState.probabilityCycleRevision;
+    pullPlayback(playback);
+}
+
+template <typename Config>
+void BasicStepSequencerStateBridge<Config>::pullPlayback(const StepSequencerPlayback& playback) {
+    if (ui_.playheadStep.get() != playback.playheadStep) {
+        ui_.playheadStep.set(playback.playheadStep);
+    }
+
+    if (ui_.probabilityCycleRevision.get() != playback.probabilityCycleRevision) {
+        ui_.probabilityCycleMask = fromStepBitMask128<StepMask>(playback.probabilityCycleMask);
+        ui_.probabilityCycleIndex = playback.probabilityCycleIndex;
+        ui_.probabilityCycleRevision.set(playback.probabilityCycleRevision);
+    }
+}
+
+using StepSequencerStateBridge = BasicStepSequencerStateBridge<>;
+
+extern template class BasicStepSequencerStateBridge<DefaultSequencerConfig>;
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,124 @@
+#include "StepSequencerStateExchange.hpp"
+
+namespace oc::note::sequencer {
+
+StepSequencerStateExchange::StepSequencerStateExchange(const StepSequencerRuntimeState& initial) {
+    for (auto& slot : slots_) {
+        slot = initial;
+        slot.dirtySteps = {};
+    }
+    publishPlayback(initial);
+}
+
+void StepSequencerStateExchange::publish() {
+    StepSequencerRuntimeState& back = slots_[back_];
+
+    // The engine has not taken the previous snapshot yet; carry its dirty steps.
+    // If it takes it meanwhile, those steps are merely applied twice.
+    const uint8_t pending = middle_.load(std::memory_order_acquire);
+    if ((pending & FRESH_BIT) != 0) {
+        back.dirtySteps |= slots_[pending & INDEX_MASK].dirtySteps;
+    }
+
+    const uint8_t published = back_;
+    const uint8_t previous =
+        middle_.exchange(static_cast<uint8_t>(published | FRESH_BIT), std::memory_order_acq_rel);
+    back_ = previous & INDEX_MASK;
+
+    // The published slot is only read from here on, by both threads.
+    slots_[back_] = slots_[published];
+    slots_[back_].dirtySteps = {};
+}
+
+bool StepSequencerStateExchange::pullInto(StepSequencerRuntimeState& target) {
+    if ((middle_.load(std::memory_order_relaxed) & FRESH_BIT) == 0) return false;
+
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+    const StepSequencerRuntimeState& snapshot = slots_[front_];
+
+    target.length = snapshot.length;
+    target.stepsPerBeat = snapshot.stepsPerBeat;
+    target.midiChannel = snapshot.midiChannel;
+    target.enabledMask = snapshot.enabledMask;
+    // Lock storage is packed across steps; steps whose locks changed are dirty below.
+    target.parameterLocks = snapshot.parameterLocks;
+
+    const uint64_t words[2] = {snapshot.dirtySteps.low, snapshot.dirtySteps.high};
+
+    // Free every dirty step's chord first so moving notes between steps always fits.
+    for (uint8_t word = 0; word < 2; ++word) {
+        uint64_t bits = words[word];
+        while (bits != 0) {
+            target.clearChord(static_cast<uint8_t>(word * 64U + __builtin_ctzll(bits)));
+            bits &= bits - 1U;
+        }
+    }
+
+    for (uint8_t word = 0; word < 2; ++word) {
+        uint64_t bits = words[word];
+        while (bits != 0) {
+            const uint8_t step = static_cast<uint8_t>(word * 64U + __builtin_ctzll(bits));
+            bits &= bits - 1U;
+
+            target.note[step] = snapshot.note[step];
+            target.velocity[step] = snapshot.velocity[step];
+            target.gate[step] = snapshot.gate[step];
+            target.nudge[step] = snapshot.nudge[step];
+            target.probability[step] = snapshot.probability[step];
+            const uint16_t chord = snapshot.chordOffset(step);
+            target.setChord(step,
+                            snapshot.chordNote.data() + chord,
+                            snapshot.chordVelocity.data() + chord,
+                            snapshot.chordSize(step));
+            target.markStepDirty(step);
+        }
+    }
+    return true;
+}
+
+void StepSequencerStateExchange::publishPlayback(const StepSequencerRuntimeState& engineState) {
+    // Only this thread writes the fields, so it may read them back without the sequence.
+    if (engineState.playheadStep == playback_step_.load(std::memory_order_relaxed)
+        && engineState.probabilityCycleRevision == playback_revision_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const uint32_t sequence = playback_sequence_.load(std::memory_order_relaxed);
+    playback_sequence_.store(sequence + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    playback_step_.store(engineState.playheadStep, std::memory_order_relaxed);
+    playback_cycle_index_.store(engineState.probabilityCycleIndex, std::memory_order_relaxed);
+    const uint64_t mask[2] = {engineState.probabilityCycleMask.low, engineState.probabilityCycleMask.high};
+    for (size_t i = 0; i < playback_mask_words_.size(); ++i) {
+        const uint32_t word = static_cast<uint32_t>(mask[i / 2U] >> ((i % 2U) * 32U));
+        playback_mask_words_[i].store(word, std::memory_order_relaxed);
+    }
+    playback_revision_.store(engineState.probabilityCycleRevision, std::memory_order_relaxed);
+
+    playback_sequence_.store(sequence + 2U, std::memory_order_release);
+}
+
+StepSequencerPlayback StepSequencerStateExchange::playback() const {
+    StepSequencerPlayback out;
+    for (;;) {
+        const uint32_t before = playback_sequence_.load(std::memory_order_acquire);
+        if ((before & 1U) != 0) continue;
+
+        out.playheadStep = static_cast<int16_t>(playback_step_.load(std::memory_order_relaxed));
+        out.probabilityCycleIndex = playback_cycle_index_.load(std::memory_order_relaxed);
+        uint64_t mask[2] = {0, 0};
+        for (size_t i = 0; i < playback_mask_words_.size(); ++i) {
+            const uint64_t word = playback_mask_words_[i].load(std::memory_order_relaxed);
+            mask[i / 2U] |= word << ((i % 2U) * 32U);
+        }
+        out.probabilityCycleMask.low = mask[0];
+        out.probabilityCycleMask.high = mask[1];
+        out.probabilityCycleRevision = playback_revision_.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (playback_sequence_.load(std::memory_order_relaxed) == before) return out;
+    }
+}
+
+}  // namespace oc::note::sequencer
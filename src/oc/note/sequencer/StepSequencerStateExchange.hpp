@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "StepBitMask128.hpp"
+#include "StepSequencerRuntimeState.hpp"
+
+namespace oc::note::sequencer {
+
+/// Engine playback fields as last published through `StepSequencerStateExchange`.
+struct StepSequencerPlayback {
+    int16_t playheadStep = -1;
+    uint32_t probabilityCycleIndex = 0;
+    StepBitMask128 probabilityCycleMask{};
+    uint32_t probabilityCycleRevision = 0;
+};
+
+/**
+ * @brief Triple-buffered pattern handoff from one editing thread to one engine
+ *
+ * The editor changes `edit()` through the runtime-state setters and calls
+ * `publish()` when a batch of edits is complete. The engine side takes the
+ * newest published snapshot with `pullInto()`, which is wait-free (one atomic
+ * exchange) and never sees a half-written batch. Snapshots the engine skips
+ * keep their dirty steps: they are folded into the next publish.
+ *
+ * Only pattern data travels this way: length, steps-per-beat, channel, enabled
+ * mask and the per-step arrays, chords and parameter locks.
+ *
+ * Playback goes the other way. The engine writes its playhead and
+ * probability-cycle fields with `publishPlayback()` and any other thread reads
+ * them with `playback()`. A sequence counter brackets each write, so a reader
+ * retries rather than returning a mix of two publishes; the engine never waits.
+ */
+class StepSequencerStateExchange {
+public:
+    explicit StepSequencerStateExchange(const StepSequencerRuntimeState& initial);
+
+    StepSequencerStateExchange(const StepSequencerStateExchange&) = delete;
+    StepSequencerStateExchange& operator=(const StepSequencerStateExchange&) = delete;
+
+    /// Editor thread: working copy for the next snapshot.
+    StepSequencerRuntimeState& edit() { return slots_[back_]; }
+
+    /// Editor thread: make the edits since the last publish visible as one batch.
+    void publish();
+
+    /**
+     * @brief Engine thread: apply the newest snapshot, if any, to `target`
+     *
+     * Scalars are copied as-is; per-step data is copied for the snapshot's
+     * dirty steps only, which are then marked dirty on `target`. Returns false
+     * when nothing new was published.
+     */
+    bool pullInto(StepSequencerRuntimeState& target);
+
+    /// Engine thread: make the playback fields of `engineState` visible to `playback()`.
+    void publishPlayback(const StepSequencerRuntimeState& engineState);
+
+    /// Any thread: the playback fields of the latest `publishPlayback()`, never torn.
+    StepSequencerPlayback playback() const;
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03u;
+    static constexpr uint8_t FRESH_BIT = 0x04u;
+
+    std::array<StepSequencerRuntimeState, 3> slots_;
+    uint8_t back_ = 0;
+    std::atomic<uint8_t> middle_{1};
+    uint8_t front_ = 2;
+
+    // Odd while the engine is writing the playback fields below. Every field is
+    // 32 bits wide so 32-bit MCUs store them without libatomic.
+    std::atomic<uint32_t> playback_sequence_{0};
+    std::atomic<int32_t> playback_step_{-1};
+    std::atomic<uint32_t> playback_cycle_index_{0};
+    std::array<std::atomic<uint32_t>, 4> playback_mask_words_{};
+    std::atomic<uint32_t> playback_revision_{0};
+};
+
+}  // namespace oc::note::sequencer
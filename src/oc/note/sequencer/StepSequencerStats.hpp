@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+// Define to 1 for the whole build (e.g. `target_compile_definitions`) to compile
+// engine counters in. Every translation unit must agree on the value.
+#ifndef OC_NOTE_ENGINE_STATS
+#define OC_NOTE_ENGINE_STATS 0
+#endif
+
+namespace oc::note::sequencer {
+
+/// Free-running host counter (e.g. DWT->CYCCNT); differences are taken modulo 2^32.
+using StatsCycleCounter = uint32_t (*)();
+
+/**
+ * @brief Field counters for one engine
+ *
+ * Counters saturate instead of wrapping. All stay zero when the engine is
+ * built without `OC_NOTE_ENGINE_STATS`.
+ */
+struct StepSequencerStats {
+    uint32_t updates = 0;
+    uint32_t stepsAdvanced = 0;
+    uint32_t maxStepsPerUpdate = 0;
+
+    uint32_t schedulerPeak = 0;
+    uint32_t schedulerOverflows = 0;
+    uint32_t sinkFailures = 0;
+
+    uint32_t cycleMaskHits = 0;
+    uint32_t cycleMaskMisses = 0;
+
+    /// `update()` duration in host counter units; 0 until a counter is installed.
+    uint32_t lastUpdateCycles = 0;
+    uint32_t maxUpdateCycles = 0;
+
+    static void bump(uint32_t& counter, uint32_t amount = 1U) {
+        counter = (counter > UINT32_MAX - amount) ? UINT32_MAX : counter + amount;
+    }
+
+    static void raise(uint32_t& peak, uint32_t value) {
+        if (value > peak) peak = value;
+    }
+};
+
+}  // namespace oc::note::sequencer
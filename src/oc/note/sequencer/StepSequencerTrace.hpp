@@ -0,0 +1,285 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <oc/note/clock/InternalClock.hpp>
+
+#include "SequencerEvent.hpp"
+#include "StepSequencerEngine.hpp"
+#include "StepSequencerRuntimeState.hpp"
+
+namespace oc::note::sequencer {
+
+enum class TraceRecordKind : uint8_t {
+    Update,           // tick, arg = playing
+    Reset,
+    Resync,           // tick
+    RunSeed,          // tick = seed passed to setNextRunSeed
+    TicksPerQuarter,  // aux
+    StatePatch,       // aux = byte offset into the state, arg = length (1..8), data = bytes
+    Event,            // tick, arg = 1 when the sink accepted it, data = type, channel, note, velocity
+    ClockReset,
+    ClockPlaying,     // arg
+    ClockBpm,         // data = float
+    ClockTicksPerQuarter,  // aux
+    ClockUpdateMs,    // tick = nowMs
+    ClockUpdateUs,    // data = nowUs
+    ClockTick,        // tick = clock output after the preceding update
+};
+
+/**
+ * @brief One fixed-size trace entry (16 bytes, host byte order)
+ *
+ * Inputs (calls and state edits) and outputs (events with their sink result,
+ * clock ticks) share one stream in call order, so a replay can feed the
+ * inputs back and compare each output as it is produced.
+ */
+struct TraceRecord {
+    TraceRecordKind kind = TraceRecordKind::Update;
+    uint8_t arg = 0;
+    uint16_t aux = 0;
+    uint32_t tick = 0;
+    uint8_t data[8] = {};
+};
+
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord is the on-disk record layout");
+static_assert(std::is_trivially_copyable<StepSequencerRuntimeState>::value,
+              "state patches copy StepSequencerRuntimeState bytewise");
+static_assert(sizeof(StepSequencerRuntimeState) <= UINT16_MAX, "state patch offsets are 16-bit");
+
+inline TraceRecord makeEventRecord(const SequencerEvent& event, bool accepted) {
+    TraceRecord record;
+    record.kind = TraceRecordKind::Event;
+    record.arg = accepted ? 1U : 0U;
+    record.tick = event.tick;
+    record.data[0] = static_cast<uint8_t>(event.type);
+    record.data[1] = event.channel;
+    record.data[2] = event.note;
+    record.data[3] = event.velocity;
+    return record;
+}
+
+/**
+ * @brief Fixed-capacity trace of engine and clock activity
+ *
+ * `begin` snapshots the pattern; after that, host edits are stored as 8-byte
+ * patches against a shadow copy, taken just before each engine call. No heap
+ * is used. When the buffer is full further records are counted in
+ * `dropped()` rather than overwriting the start, so a trace always replays
+ * from its snapshot; `complete()` tells whether it can be replayed bit-exactly.
+ */
+template <size_t Capacity>
+class BasicSequencerTrace {
+public:
+    static constexpr size_t CAPACITY = Capacity;
+    static constexpr size_t PATCH_BYTES = sizeof(TraceRecord::data);
+
+    void begin(const StepSequencerRuntimeState& state) {
+        std::memcpy(&initial_, &state, sizeof(state));
+        std::memcpy(&shadow_, &state, sizeof(state));
+        size_ = 0;
+        dropped_ = 0;
+    }
+
+    bool append(const TraceRecord& record) {
+        if (size_ == Capacity) {
+            ++dropped_;
+            return false;
+        }
+        records_[size_++] = record;
+        return true;
+    }
+
+    /// Record every byte range of `state` that differs from the last sync.
+    void recordStateChanges(const StepSequencerRuntimeState& state) {
+        const auto* current = reinterpret_cast<const uint8_t*>(&state);
+        auto* shadow = reinterpret_cast<uint8_t*>(&shadow_);
+        if (std::memcmp(current, shadow, sizeof(state)) == 0) return;
+
+        for (size_t offset = 0; offset < sizeof(state); offset += PATCH_BYTES) {
+            const size_t remaining = sizeof(state) - offset;
+            const size_t length = (remaining < PATCH_BYTES) ? remaining : PATCH_BYTES;
+            if (std::memcmp(current + offset, shadow + offset, length) == 0) continue;
+
+            TraceRecord record;
+            record.kind = TraceRecordKind::StatePatch;
+            record.arg = static_cast<uint8_t>(length);
+            record.aux = static_cast<uint16_t>(offset);
+            std::memcpy(record.data, current + offset, length);
+            append(record);
+            std::memcpy(shadow + offset, current + offset, length);
+        }
+    }
+
+    /// Take the engine's own writes (playhead, cycle masks) without recording them.
+    void syncState(const StepSequencerRuntimeState& state) { std::memcpy(&shadow_, &state, sizeof(state)); }
+
+    const StepSequencerRuntimeState& initialState() const { return initial_; }
+    const TraceRecord* records() const { return records_.data(); }
+    size_t size() const { return size_; }
+    size_t dropped() const { return dropped_; }
+    bool complete() const { return dropped_ == 0; }
+
+private:
+    std::array<TraceRecord, Capacity> records_{};
+    StepSequencerRuntimeState initial_{};
+    StepSequencerRuntimeState shadow_{};
+    size_t size_ = 0;
+    size_t dropped_ = 0;
+};
+
+/// 4096 records (64 KiB) plus two state copies.
+using SequencerTrace = BasicSequencerTrace<4096>;
+
+/**
+ * @brief `StepSequencerEngine` that records its inputs and outputs to a trace
+ *
+ * Forwards `update`, `reset`, `resyncToTick`, `setNextRunSeed` and
+ * `setTicksPerQuarter`, recording each call, the state edits made before it
+ * and every event with the wrapped sink's answer. Construction starts the
+ * trace. Edits must reach the state between calls (directly or through a
+ * bridge); a `StepSequencerStateExchange` source is pulled inside `update` and
+ * would not be captured.
+ */
+template <typename Sink, typename Trace = SequencerTrace>
+class TracedStepSequencerEngine {
+public:
+    TracedStepSequencerEngine(StepSequencerRuntimeState& state, Sink& eventSink, Trace& trace)
+        : state_(state)
+        , trace_(trace)
+        , recording_sink_{eventSink, trace}
+        , engine_(state, recording_sink_) {
+        trace_.begin(state_);
+    }
+
+    void reset() { call_(TraceRecordKind::Reset, 0, false, [this] { engine_.reset(); }); }
+
+    void update(uint32_t tick, bool playing) {
+        call_(TraceRecordKind::Update, tick, playing, [&] { engine_.update(tick, playing); });
+    }
+
+    void resyncToTick(uint32_t tick) {
+        call_(TraceRecordKind::Resync, tick, false, [&] { engine_.resyncToTick(tick); });
+    }
+
+    void setNextRunSeed(uint32_t seed) {
+        call_(TraceRecordKind::RunSeed, seed, false, [&] { engine_.setNextRunSeed(seed); });
+    }
+
+    void setTicksPerQuarter(uint16_t ticksPerQuarter) {
+        TraceRecord record;
+        record.kind = TraceRecordKind::TicksPerQuarter;
+        record.aux = ticksPerQuarter;
+        trace_.append(record);
+        engine_.setTicksPerQuarter(ticksPerQuarter);
+    }
+
+    bool isPlaying() const { return engine_.isPlaying(); }
+
+private:
+    struct RecordingSink_ {
+        bool emitSequencerEvent(const SequencerEvent& event) {
+            const bool accepted = sink.emitSequencerEvent(event);
+            trace.append(makeEventRecord(event, accepted));
+            return accepted;
+        }
+
+        size_t emitSequencerEvents(const SequencerEvent* events, size_t count) {
+            const size_t accepted = sink.emitSequencerEvents(events, count);
+            for (size_t i = 0; i < accepted; ++i) trace.append(makeEventRecord(events[i], true));
+            if (accepted < count) trace.append(makeEventRecord(events[accepted], false));
+            return accepted;
+        }
+
+        Sink& sink;
+        Trace& trace;
+    };
+
+    template <typename Call>
+    void call_(TraceRecordKind kind, uint32_t tick, bool arg, Call&& call) {
+        trace_.recordStateChanges(state_);
+        TraceRecord record;
+        record.kind = kind;
+        record.arg = arg ? 1U : 0U;
+        record.tick = tick;
+        trace_.append(record);
+        call();
+        trace_.syncState(state_);
+    }
+
+    StepSequencerRuntimeState& state_;
+    Trace& trace_;
+    RecordingSink_ recording_sink_;
+    BasicStepSequencerEngine<RecordingSink_> engine_;
+};
+
+/// `InternalClock` that records its inputs and resulting tick into a shared trace.
+template <typename Trace = SequencerTrace>
+class TracedInternalClock {
+public:
+    explicit TracedInternalClock(Trace& trace)
+        : trace_(trace) {}
+
+    void reset() {
+        append_(TraceRecordKind::ClockReset);
+        clock_.reset();
+    }
+
+    void setPlaying(bool playing) {
+        append_(TraceRecordKind::ClockPlaying, 0, playing ? 1U : 0U);
+        clock_.setPlaying(playing);
+    }
+
+    void setBpm(float bpm) {
+        TraceRecord record;
+        record.kind = TraceRecordKind::ClockBpm;
+        std::memcpy(record.data, &bpm, sizeof(bpm));
+        trace_.append(record);
+        clock_.setBpm(bpm);
+    }
+
+    void setTicksPerQuarter(uint16_t ticksPerQuarter) {
+        TraceRecord record;
+        record.kind = TraceRecordKind::ClockTicksPerQuarter;
+        record.aux = ticksPerQuarter;
+        trace_.append(record);
+        clock_.setTicksPerQuarter(ticksPerQuarter);
+    }
+
+    void update(uint32_t nowMs) {
+        append_(TraceRecordKind::ClockUpdateMs, nowMs);
+        clock_.update(nowMs);
+        append_(TraceRecordKind::ClockTick, clock_.tick());
+    }
+
+    void updateUs(uint64_t nowUs) {
+        TraceRecord record;
+        record.kind = TraceRecordKind::ClockUpdateUs;
+        std::memcpy(record.data, &nowUs, sizeof(nowUs));
+        trace_.append(record);
+        clock_.updateUs(nowUs);
+        append_(TraceRecordKind::ClockTick, clock_.tick());
+    }
+
+    const oc::note::clock::InternalClock& clock() const { return clock_; }
+    uint32_t tick() const { return clock_.tick(); }
+    bool isPlaying() const { return clock_.isPlaying(); }
+
+private:
+    void append_(TraceRecordKind kind, uint32_t tick = 0, uint8_t arg = 0) {
+        TraceRecord record;
+        record.kind = kind;
+        record.arg = arg;
+        record.tick = tick;
+        trace_.append(record);
+    }
+
+    Trace& trace_;
+    oc::note::clock::InternalClock clock_;
+};
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,218 @@
+#include "StepSequencerTraceReplay.hpp"
+
+#include <cstring>
+
+#include <oc/note/clock/InternalClock.hpp>
+
+#include "StepSequencerEngine.hpp"
+
+namespace oc::note::sequencer {
+
+namespace {
+
+constexpr uint8_t TRACE_MAGIC[4] = {'O', 'C', 'N', 'T'};
+constexpr uint16_t TRACE_VERSION = 1;
+
+struct TraceFileHeader {
+    uint8_t magic[4];
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t stateSize;
+    uint32_t recordCount;
+};
+
+static_assert(sizeof(TraceFileHeader) == 16, "TraceFileHeader must stay packed");
+
+/// Hands each emitted event to the cursor, which checks it and returns the recorded sink answer.
+class ReplayCursor {
+public:
+    ReplayCursor(const TraceRecord* records, size_t count)
+        : records_(records)
+        , count_(count) {}
+
+    bool matchEvent(const SequencerEvent& event) {
+        if (failed_) return true;
+        const TraceRecord expected = makeEventRecord(event, true);
+        if (index_ >= count_ || records_[index_].kind != TraceRecordKind::Event
+            || records_[index_].tick != expected.tick
+            || std::memcmp(records_[index_].data, expected.data, sizeof(expected.data)) != 0) {
+            fail(index_);
+            return true;
+        }
+        ++events_;
+        return records_[index_++].arg != 0;
+    }
+
+    bool failed() const { return failed_; }
+    size_t mismatch() const { return mismatch_; }
+    void fail(size_t at) {
+        failed_ = true;
+        mismatch_ = at;
+    }
+    size_t index() const { return index_; }
+    void advance() { ++index_; }
+    bool atEnd() const { return index_ >= count_; }
+    const TraceRecord& current() const { return records_[index_]; }
+    uint32_t events() const { return events_; }
+
+private:
+    const TraceRecord* records_;
+    size_t count_;
+    size_t index_ = 0;
+    size_t mismatch_ = 0;
+    uint32_t events_ = 0;
+    bool failed_ = false;
+};
+
+struct ReplaySink {
+    bool emitSequencerEvent(const SequencerEvent& event) { return cursor.matchEvent(event); }
+
+    size_t emitSequencerEvents(const SequencerEvent* events, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!cursor.matchEvent(events[i])) return i;
+        }
+        return count;
+    }
+
+    ReplayCursor& cursor;
+};
+
+void applyPatch(StepSequencerRuntimeState& state, const TraceRecord& record) {
+    const size_t length = (record.arg > sizeof(record.data)) ? sizeof(record.data) : record.arg;
+    if (record.aux + length > sizeof(state)) return;
+    std::memcpy(reinterpret_cast<uint8_t*>(&state) + record.aux, record.data, length);
+}
+
+}  // namespace
+
+TraceReplayResult replayTrace(const StepSequencerRuntimeState& initialState,
+                              const TraceRecord* records,
+                              size_t recordCount) {
+    StepSequencerRuntimeState state;
+    std::memcpy(&state, &initialState, sizeof(state));
+
+    ReplayCursor cursor(records, recordCount);
+    ReplaySink sink{cursor};
+    BasicStepSequencerEngine<ReplaySink> engine(state, sink);
+    oc::note::clock::InternalClock clock;
+    TraceReplayResult result{};
+
+    while (!cursor.atEnd() && !cursor.failed()) {
+        const TraceRecord record = cursor.current();
+        cursor.advance();
+
+        switch (record.kind) {
+            case TraceRecordKind::Update:
+                engine.update(record.tick, record.arg != 0);
+                ++result.updateCount;
+                break;
+            case TraceRecordKind::Reset:
+                engine.reset();
+                break;
+            case TraceRecordKind::Resync:
+                engine.resyncToTick(record.tick);
+                break;
+            case TraceRecordKind::RunSeed:
+                engine.setNextRunSeed(record.tick);
+                break;
+            case TraceRecordKind::TicksPerQuarter:
+                engine.setTicksPerQuarter(record.aux);
+                break;
+            case TraceRecordKind::StatePatch:
+                applyPatch(state, record);
+                break;
+            case TraceRecordKind::ClockReset:
+                clock.reset();
+                break;
+            case TraceRecordKind::ClockPlaying:
+                clock.setPlaying(record.arg != 0);
+                break;
+            case TraceRecordKind::ClockBpm: {
+                float bpm = 0.0f;
+                std::memcpy(&bpm, record.data, sizeof(bpm));
+                clock.setBpm(bpm);
+                break;
+            }
+            case TraceRecordKind::ClockTicksPerQuarter:
+                clock.setTicksPerQuarter(record.aux);
+                break;
+            case TraceRecordKind::ClockUpdateMs:
+                clock.update(record.tick);
+                break;
+            case TraceRecordKind::ClockUpdateUs: {
+                uint64_t nowUs = 0;
+                std::memcpy(&nowUs, record.data, sizeof(nowUs));
+                clock.updateUs(nowUs);
+                break;
+            }
+            case TraceRecordKind::ClockTick:
+                if (record.tick != clock.tick()) cursor.fail(cursor.index() - 1U);
+                break;
+            case TraceRecordKind::Event:
+                // An event the replay did not produce.
+                cursor.fail(cursor.index() - 1U);
+                break;
+        }
+    }
+
+    result.matched = !cursor.failed();
+    result.firstMismatch = result.matched ? recordCount : cursor.mismatch();
+    result.eventCount = cursor.events();
+    return result;
+}
+
+size_t traceFileSize(size_t recordCount) {
+    return sizeof(TraceFileHeader) + sizeof(StepSequencerRuntimeState) + recordCount * sizeof(TraceRecord);
+}
+
+size_t writeTraceFile(const StepSequencerRuntimeState& initialState,
+                      const TraceRecord* records,
+                      size_t recordCount,
+                      uint8_t* out,
+                      size_t capacity) {
+    const size_t total = traceFileSize(recordCount);
+    if (out == nullptr || capacity < total || recordCount > UINT32_MAX) return 0;
+
+    TraceFileHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.stateSize = sizeof(StepSequencerRuntimeState);
+    header.recordCount = static_cast<uint32_t>(recordCount);
+
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), &initialState, sizeof(initialState));
+    if (recordCount > 0) {
+        std::memcpy(out + sizeof(header) + sizeof(initialState), records, recordCount * sizeof(TraceRecord));
+    }
+    return total;
+}
+
+bool readTraceFile(const uint8_t* data,
+                   size_t size,
+                   StepSequencerRuntimeState& initialState,
+                   TraceRecord* records,
+                   size_t capacity,
+                   size_t& recordCount) {
+    recordCount = 0;
+    TraceFileHeader header{};
+    if (data == nullptr || size < sizeof(header)) return false;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != TRACE_VERSION
+        || header.recordSize != sizeof(TraceRecord)
+        || header.stateSize != sizeof(StepSequencerRuntimeState)) {
+        return false;
+    }
+    recordCount = header.recordCount;
+    if (size < traceFileSize(recordCount) || recordCount > capacity) return false;
+
+    std::memcpy(&initialState, data + sizeof(header), sizeof(initialState));
+    if (recordCount > 0) {
+        std::memcpy(records, data + sizeof(header) + sizeof(initialState), recordCount * sizeof(TraceRecord));
+    }
+    return true;
+}
+
+}  // namespace oc::note::sequencer
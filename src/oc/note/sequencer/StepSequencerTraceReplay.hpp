@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "StepSequencerRuntimeState.hpp"
+#include "StepSequencerTrace.hpp"
+
+namespace oc::note::sequencer {
+
+struct TraceReplayResult {
+    bool matched = false;
+    /// Index of the first record that did not reproduce; `recordCount` when matched.
+    size_t firstMismatch = 0;
+    uint32_t eventCount = 0;
+    uint32_t updateCount = 0;
+};
+
+/**
+ * @brief Feed a trace back into a fresh engine and clock and diff the outputs
+ *
+ * Starts from `initialState`, applies state patches and calls in recorded
+ * order, answers each emit with the sink result captured at record time, and
+ * stops at the first event or clock tick that differs (or is missing or
+ * extra). Allocation-free; cost is that of the recorded engine work plus the
+ * comparison.
+ */
+TraceReplayResult replayTrace(const StepSequencerRuntimeState& initialState,
+                              const TraceRecord* records,
+                              size_t recordCount);
+
+template <size_t Capacity>
+TraceReplayResult replayTrace(const BasicSequencerTrace<Capacity>& trace) {
+    return replayTrace(trace.initialState(), trace.records(), trace.size());
+}
+
+/**
+ * @brief Binary trace file: header, initial state bytes, then the records
+ *
+ * The header holds a magic, a format version, the record and state sizes
+ * and the record count. Everything is in host byte order and state layout, so
+ * a file replays on a build of the same target; `readTraceFile` rejects a
+ * layout mismatch.
+ */
+size_t traceFileSize(size_t recordCount);
+
+/// Returns bytes written, or 0 when `capacity` is too small.
+size_t writeTraceFile(const StepSequencerRuntimeState& initialState,
+                      const TraceRecord* records,
+                      size_t recordCount,
+                      uint8_t* out,
+                      size_t capacity);
+
+template <size_t Capacity>
+size_t writeTraceFile(const BasicSequencerTrace<Capacity>& trace, uint8_t* out, size_t capacity) {
+    return writeTraceFile(trace.initialState(), trace.records(), trace.size(), out, capacity);
+}
+
+/// Parse a file; `recordCount` is the number stored, which may exceed `capacity` (then false).
+bool readTraceFile(const uint8_t* data,
+                   size_t size,
+                   StepSequencerRuntimeState& initialState,
+                   TraceRecord* records,
+                   size_t capacity,
+                   size_t& recordCount);
+
+}  // namespace oc::note::sequencer
@@ -0,0 +1,174 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerBatchRunner.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+using oc::note::sequencer::BatchRenderJob;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerBatchRunner;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+class CollectingSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+    size_t limit = SIZE_MAX;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        if (events.size() >= limit) return false;
+        events.push_back(event);
+        return true;
+    }
+};
+
+/// Patterns of very different density and length, so jobs are uneven.
+std::vector<StepSequencerRuntimeState> makeLibrary(size_t count) {
+    std::vector<StepSequencerRuntimeState> library(count);
+    uint32_t rng = 0x12345678u;
+    for (size_t i = 0; i < count; ++i) {
+        StepSequencerRuntimeState& st = library[i];
+        st.length = static_cast<uint8_t>(4 + i % 120);
+        st.stepsPerBeat = static_cast<uint8_t>(1U << (i % 4));
+        for (uint8_t step = 0; step < st.length; ++step) {
+            rng = rng * 1664525u + 1013904223u;
+            st.enabledMask.setBit(step, (rng >> 24) % 3U != 0);
+            st.note[step] = static_cast<uint8_t>(36 + (rng >> 8) % 48U);
+            st.probability[step] = static_cast<uint8_t>(40 + (rng >> 16) % 61U);
+            st.nudge[step] = static_cast<int8_t>(static_cast<int32_t>((rng >> 4) % 41U) - 20);
+        }
+    }
+    return library;
+}
+
+bool sameEvents(const std::vector<SequencerEvent>& a, const std::vector<SequencerEvent>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].tick != b[i].tick || a[i].type != b[i].type || a[i].channel != b[i].channel
+            || a[i].note != b[i].note || a[i].velocity != b[i].velocity) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void renderLibrary(const std::vector<StepSequencerRuntimeState>& library,
+                   unsigned workers,
+                   std::vector<CollectingSink>& sinks,
+                   std::vector<BatchRenderJob>& jobs) {
+    sinks.assign(library.size(), CollectingSink{});
+    jobs.assign(library.size(), BatchRenderJob{});
+    for (size_t i = 0; i < library.size(); ++i) {
+        jobs[i].pattern = &library[i];
+        jobs[i].sink = &sinks[i];
+        jobs[i].tickCount = 24U * 4U * static_cast<uint32_t>(1 + i % 8);
+        jobs[i].runSeed = static_cast<uint32_t>(i + 1);
+    }
+    StepSequencerBatchRunner runner(workers);
+    runner.run(jobs.data(), jobs.size());
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_batch_output_does_not_depend_on_worker_count() {
+    const auto library = makeLibrary(300);
+    std::vector<CollectingSink> serialSinks;
+    std::vector<BatchRenderJob> serialJobs;
+    renderLibrary(library, 1, serialSinks, serialJobs);
+
+    std::vector<CollectingSink> parallelSinks;
+    std::vector<BatchRenderJob> parallelJobs;
+    renderLibrary(library, 6, parallelSinks, parallelJobs);
+
+    size_t total = 0;
+    for (size_t i = 0; i < library.size(); ++i) {
+        TEST_ASSERT_TRUE(serialJobs[i].complete);
+        TEST_ASSERT_TRUE(parallelJobs[i].complete);
+        TEST_ASSERT_EQUAL_UINT32(serialJobs[i].eventCount, parallelJobs[i].eventCount);
+        TEST_ASSERT_TRUE(sameEvents(serialSinks[i].events, parallelSinks[i].events));
+        total += serialSinks[i].events.size();
+    }
+    TEST_ASSERT_TRUE(total > 1000);
+}
+
+void test_batch_job_matches_a_standalone_engine() {
+    const auto library = makeLibrary(3);
+    std::vector<CollectingSink> sinks;
+    std::vector<BatchRenderJob> jobs;
+    renderLibrary(library, 2, sinks, jobs);
+
+    StepSequencerRuntimeState st = library[2];
+    CollectingSink live;
+    oc::note::sequencer::StepSequencerEngine eng(st, live);
+    eng.setNextRunSeed(3);
+    for (uint32_t tick = 0; tick < jobs[2].tickCount; ++tick) eng.update(tick, true);
+
+    TEST_ASSERT_TRUE(sameEvents(live.events, sinks[2].events));
+}
+
+void test_batch_job_stops_when_its_sink_refuses() {
+    const auto library = makeLibrary(4);
+    std::vector<CollectingSink> sinks(4);
+    std::vector<BatchRenderJob> jobs(4);
+    for (size_t i = 0; i < 4; ++i) {
+        jobs[i].pattern = &library[i];
+        jobs[i].sink = &sinks[i];
+        jobs[i].tickCount = 24U * 16U;
+    }
+    sinks[1].limit = 3;
+    jobs[3].pattern = nullptr;
+
+    StepSequencerBatchRunner runner(3);
+    TEST_ASSERT_EQUAL_UINT32(3, runner.workerCount());
+    runner.run(jobs.data(), jobs.size());
+
+    TEST_ASSERT_TRUE(jobs[0].complete);
+    TEST_ASSERT_FALSE(jobs[1].complete);
+    TEST_ASSERT_EQUAL_UINT32(3, jobs[1].eventCount);
+    TEST_ASSERT_TRUE(jobs[2].complete);
+    TEST_ASSERT_FALSE(jobs[3].complete);
+    TEST_ASSERT_EQUAL_UINT32(0, jobs[3].eventCount);
+}
+
+void test_runner_serves_repeated_runs_of_any_size() {
+    const auto library = makeLibrary(40);
+    std::vector<CollectingSink> expectedSinks;
+    std::vector<BatchRenderJob> expectedJobs;
+    renderLibrary(library, 1, expectedSinks, expectedJobs);
+
+    // One runner, its threads kept between runs, including runs with fewer jobs than workers.
+    StepSequencerBatchRunner runner(4);
+    for (const size_t count : {size_t{1}, size_t{3}, size_t{40}, size_t{2}, size_t{40}}) {
+        std::vector<CollectingSink> sinks(count);
+        std::vector<BatchRenderJob> jobs(count);
+        for (size_t i = 0; i < count; ++i) {
+            jobs[i] = expectedJobs[i];
+            jobs[i].sink = &sinks[i];
+        }
+        runner.run(jobs.data(), jobs.size());
+
+        for (size_t i = 0; i < count; ++i) {
+            TEST_ASSERT_TRUE(jobs[i].complete);
+            TEST_ASSERT_TRUE(sameEvents(expectedSinks[i].events, sinks[i].events));
+        }
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_batch_output_does_not_depend_on_worker_count);
+    RUN_TEST(test_batch_job_matches_a_standalone_engine);
+    RUN_TEST(test_batch_job_stops_when_its_sink_refuses);
+    RUN_TEST(test_runner_serves_repeated_runs_of_any_size);
+    return UNITY_END();
+}
@@ -0,0 +1,175 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/sequencer/NoteScheduler.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+using oc::note::sequencer::BasicNoteScheduler;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::NoteScheduler;
+using oc::note::sequencer::OverflowPolicy;
+using oc::note::sequencer::ScheduleStatus;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+class MockEventSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        events.push_back(event);
+        return true;
+    }
+};
+
+const uint8_t TRIAD_NOTES[] = {64, 67, 71};
+const uint8_t TRIAD_VELOCITIES[] = {90, 80, 70};
+
+std::vector<SequencerEvent> eventsAt(const std::vector<SequencerEvent>& events,
+                                     uint32_t tick,
+                                     SequencerEventType type) {
+    std::vector<SequencerEvent> found;
+    for (const auto& e : events) {
+        if (e.tick == tick && e.type == type) found.push_back(e);
+    }
+    return found;
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_chords_pack_in_step_order_and_compact() {
+    StepSequencerRuntimeState st;
+    TEST_ASSERT_TRUE(st.setChord(5, TRIAD_NOTES, TRIAD_VELOCITIES, 2));
+    TEST_ASSERT_TRUE(st.setChord(2, TRIAD_NOTES, TRIAD_VELOCITIES, 3));
+    TEST_ASSERT_EQUAL_UINT16(5, st.chordArenaUsed);
+    TEST_ASSERT_EQUAL_UINT16(3, st.chordOffset(5));
+    TEST_ASSERT_EQUAL_UINT8(64, st.chordNote[st.chordOffset(5)]);
+
+    st.clearChord(2);
+    TEST_ASSERT_EQUAL_UINT16(2, st.chordArenaUsed);
+    TEST_ASSERT_EQUAL_UINT16(0, st.chordOffset(5));
+    TEST_ASSERT_EQUAL_UINT8(67, st.chordNote[1]);
+    TEST_ASSERT_EQUAL_UINT8(80, st.chordVelocity[1]);
+    TEST_ASSERT_TRUE(st.dirtySteps.test(2));
+
+    const uint8_t tooMany[StepSequencerRuntimeState::MAX_CHORD_SIZE] = {};
+    TEST_ASSERT_FALSE(st.setChord(1, tooMany, tooMany, StepSequencerRuntimeState::MAX_CHORD_SIZE));
+
+    for (uint8_t step = 0; step < StepSequencerRuntimeState::MAX_STEPS; ++step) {
+        st.setChord(step, TRIAD_NOTES, TRIAD_VELOCITIES, 2);
+    }
+    TEST_ASSERT_EQUAL_UINT16(StepSequencerRuntimeState::CHORD_ARENA_SIZE, st.chordArenaUsed);
+    TEST_ASSERT_FALSE(st.setChord(7, TRIAD_NOTES, TRIAD_VELOCITIES, 3));
+    TEST_ASSERT_EQUAL_UINT8(2, st.chordSize(7));
+    TEST_ASSERT_EQUAL_UINT16(14, st.chordOffset(7));
+}
+
+void test_scheduler_queues_chord_as_one_batch_or_per_policy() {
+    NoteScheduler scheduler;
+    MockEventSink sink;
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Queued),
+                      static_cast<int>(scheduler.scheduleChord(4, 10, 1, TRIAD_NOTES, TRIAD_VELOCITIES, 3)));
+    TEST_ASSERT_TRUE(scheduler.processUntil(100, sink));
+    TEST_ASSERT_EQUAL(6, static_cast<int>(sink.events.size()));
+    for (size_t i = 0; i < 3; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(TRIAD_NOTES[i], sink.events[i].note);
+        TEST_ASSERT_EQUAL_UINT32(4, sink.events[i].tick);
+        TEST_ASSERT_EQUAL_UINT32(10, sink.events[i + 3].tick);
+    }
+
+    BasicNoteScheduler<4> clearAll;
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Rejected),
+                      static_cast<int>(clearAll.scheduleChord(4, 10, 1, TRIAD_NOTES, TRIAD_VELOCITIES, 3)));
+    TEST_ASSERT_EQUAL(0, static_cast<int>(clearAll.size()));
+
+    BasicNoteScheduler<4, OverflowPolicy::DropNewest> dropNewest;
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Dropped),
+                      static_cast<int>(dropNewest.scheduleChord(4, 10, 1, TRIAD_NOTES, TRIAD_VELOCITIES, 3)));
+    TEST_ASSERT_EQUAL(4, static_cast<int>(dropNewest.size()));
+}
+
+void test_engine_sounds_whole_chord_and_reschedules_chord_edits() {
+    StepSequencerRuntimeState st;
+    st.length = 2;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(2);
+    st.note[0] = 60;
+    st.note[1] = 62;
+    st.gate[0] = 50;
+    st.gate[1] = 50;
+    st.setChord(0, TRIAD_NOTES, TRIAD_VELOCITIES, 2);
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    for (uint32_t tick = 0; tick <= 3; ++tick) {
+        eng.update(tick, true);
+    }
+    TEST_ASSERT_EQUAL(3, static_cast<int>(eventsAt(sink.events, 0, SequencerEventType::NoteOn).size()));
+    TEST_ASSERT_EQUAL(3, static_cast<int>(eventsAt(sink.events, 3, SequencerEventType::NoteOff).size()));
+
+    // Step 0 of the next cycle (tick 12) is already queued when the chord changes.
+    for (uint32_t tick = 4; tick <= 7; ++tick) {
+        eng.update(tick, true);
+    }
+    st.setChord(0, TRIAD_NOTES + 1, TRIAD_VELOCITIES + 1, 2);
+    st.setChord(1, TRIAD_NOTES, TRIAD_VELOCITIES, 1);
+    for (uint32_t tick = 8; tick <= 18; ++tick) {
+        eng.update(tick, true);
+    }
+
+    const auto chordOn = eventsAt(sink.events, 12, SequencerEventType::NoteOn);
+    TEST_ASSERT_EQUAL(3, static_cast<int>(chordOn.size()));
+    TEST_ASSERT_EQUAL_UINT8(60, chordOn[0].note);
+    TEST_ASSERT_EQUAL_UINT8(67, chordOn[1].note);
+    TEST_ASSERT_EQUAL_UINT8(71, chordOn[2].note);
+    TEST_ASSERT_EQUAL_UINT8(70, chordOn[2].velocity);
+    TEST_ASSERT_EQUAL(3, static_cast<int>(eventsAt(sink.events, 15, SequencerEventType::NoteOff).size()));
+    TEST_ASSERT_EQUAL(1, static_cast<int>(eventsAt(sink.events, 6, SequencerEventType::NoteOn).size()));
+    TEST_ASSERT_EQUAL(2, static_cast<int>(eventsAt(sink.events, 18, SequencerEventType::NoteOn).size()));
+}
+
+void test_engine_plays_only_own_note_for_inconsistent_chord_directory() {
+    StepSequencerRuntimeState st;
+    st.length = 2;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(2);
+    st.note[0] = 60;
+    st.note[1] = 62;
+    st.setChord(0, TRIAD_NOTES, TRIAD_VELOCITIES, 2);
+    st.setChord(1, TRIAD_NOTES, TRIAD_VELOCITIES, 3);
+    // Written without the setters: step 1's chord would run past the arena.
+    st.chordStart[1] = 254;
+    st.chordArenaUsed = 259;
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    for (uint32_t tick = 0; tick <= 8; ++tick) {
+        eng.update(tick, true);
+    }
+
+    const auto onsets = eventsAt(sink.events, 6, SequencerEventType::NoteOn);
+    TEST_ASSERT_EQUAL(1, static_cast<int>(onsets.size()));
+    TEST_ASSERT_EQUAL_UINT8(62, onsets[0].note);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_chords_pack_in_step_order_and_compact);
+    RUN_TEST(test_scheduler_queues_chord_as_one_batch_or_per_policy);
+    RUN_TEST(test_engine_sounds_whole_chord_and_reschedules_chord_edits);
+    RUN_TEST(test_engine_plays_only_own_note_for_inconsistent_chord_directory);
+    return UNITY_END();
+}
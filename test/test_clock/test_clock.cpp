@@ -1,8 +1,89 @@
 #include <unity.h>
 
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <oc/note/clock/ExternalClock.hpp>
 #include <oc/note/clock/InternalClock.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
 
+using oc::note::clock::ExternalClock;
 using oc::note::clock::InternalClock;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+constexpr uint64_t PULSE_US_120_BPM = 20'833;
+
+// Deterministic jitter in [-limitUs, +limitUs].
+struct JitterSource {
+    uint32_t state = 12345;
+
+    int32_t next(int32_t limitUs) {
+        state = state * 1664525U + 1013904223U;
+        return static_cast<int32_t>((state >> 8) % static_cast<uint32_t>(2 * limitUs + 1)) - limitUs;
+    }
+};
+
+class TimedEventSink final : public ISequencerEventSink {
+public:
+    uint64_t nowUs = 0;
+    std::vector<uint64_t> noteOnUs;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        if (event.type == SequencerEventType::NoteOn) noteOnUs.push_back(nowUs);
+        return true;
+    }
+};
+
+// Largest distance between a NoteOn and the ideal sixteenth grid, skipping warm-up.
+uint64_t maxNoteOnDeviationUs(bool followWithPll) {
+    StepSequencerRuntimeState st;
+    st.length = 16;
+    st.enabledMask = StepBitMask128::prefixMask(16);
+    TimedEventSink sink;
+    StepSequencerEngine eng(st, sink);
+
+    ExternalClock clk;
+    JitterSource jitter;
+    static constexpr uint32_t PULSES = 3000;
+    static constexpr uint64_t START_US = 1'000'000;
+    clk.start();
+
+    uint32_t pulses = 0;
+    uint64_t nextPulseUs = START_US;
+    for (uint64_t now = START_US - 1'000; now < START_US + PULSES * PULSE_US_120_BPM; now += 100) {
+        while (pulses < PULSES && nextPulseUs <= now) {
+            clk.pulse(nextPulseUs);
+            ++pulses;
+            const uint64_t ideal = START_US + pulses * PULSE_US_120_BPM;
+            nextPulseUs = static_cast<uint64_t>(static_cast<int64_t>(ideal) + jitter.next(2'000));
+        }
+        clk.updateUs(now);
+        sink.nowUs = now;
+        const uint32_t tick = followWithPll ? clk.tick() : (pulses > 0 ? pulses - 1U : 0U);
+        eng.update(tick, pulses > 0);
+    }
+
+    uint64_t worst = 0;
+    for (size_t i = 100; i < sink.noteOnUs.size(); ++i) {
+        const int64_t ideal = static_cast<int64_t>(START_US + i * 6U * PULSE_US_120_BPM);
+        const int64_t actual = static_cast<int64_t>(sink.noteOnUs[i]);
+        const uint64_t deviation = static_cast<uint64_t>(std::llabs(actual - ideal));
+        if (deviation > worst) worst = deviation;
+    }
+    return worst;
+}
+
+}  // namespace
 
 void setUp() {}
 
@@ -47,9 +128,190 @@ void test_internal_clock_resets_on_start() {
     TEST_ASSERT_EQUAL_UINT32(0, clk.tick());
 }
 
+void test_internal_clock_us_input_carries_sub_tick_phase() {
+    InternalClock clk;
+    clk.setBpm(130.0f);  // tick period = 19230.77us, not a whole number of µs
+    clk.setPlaying(true);
+    clk.updateUs(1'000'000);
+
+    // 1000 ticks at 130 BPM take exactly 19'230'769.23us.
+    uint64_t now = 1'000'000;
+    while (now < 1'000'000 + 19'230'769) {
+        now += 997;
+        if (now > 1'000'000 + 19'230'769) now = 1'000'000 + 19'230'769;
+        clk.updateUs(now);
+    }
+    TEST_ASSERT_EQUAL_UINT32(999, clk.tick());
+    TEST_ASSERT_TRUE(clk.tickPhase() > 0.99f);
+
+    clk.updateUs(now + 1);
+    TEST_ASSERT_EQUAL_UINT32(1000, clk.tick());
+    TEST_ASSERT_TRUE(clk.tickPhase() < 0.01f);
+}
+
+void test_internal_clock_tick_phase_tracks_position_in_tick() {
+    InternalClock clk;
+    clk.setBpm(125.0f);  // tick period = 20000us
+    clk.setPlaying(true);
+    clk.updateUs(0);
+
+    clk.updateUs(5'000);
+    TEST_ASSERT_EQUAL_UINT32(0, clk.tick());
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.25f, clk.tickPhase());
+
+    clk.updateUs(50'000);
+    TEST_ASSERT_EQUAL_UINT32(2, clk.tick());
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.5f, clk.tickPhase());
+
+    // Tempo changes keep the phase already accumulated.
+    clk.setBpm(250.0f);  // tick period = 10000us
+    clk.updateUs(55'000);
+    TEST_ASSERT_EQUAL_UINT32(3, clk.tick());
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, clk.tickPhase());
+}
+
+void test_internal_clock_high_resolution_derives_midi_clock() {
+    InternalClock clk;
+    clk.setBpm(125.0f);  // MIDI Clock pulse = 20000us
+    clk.setTicksPerQuarter(960);
+    clk.setPlaying(true);
+    clk.updateUs(0);
+
+    clk.updateUs(500);
+    TEST_ASSERT_EQUAL_UINT32(1, clk.tick());
+    TEST_ASSERT_EQUAL_UINT32(0, clk.midiClockPulse());
+
+    clk.updateUs(20'000);
+    TEST_ASSERT_EQUAL_UINT32(40, clk.tick());
+    TEST_ASSERT_EQUAL_UINT32(1, clk.midiClockPulse());
+
+    clk.updateUs(1'000'000);
+    TEST_ASSERT_EQUAL_UINT32(2000, clk.tick());
+    TEST_ASSERT_EQUAL_UINT32(50, clk.midiClockPulse());
+}
+
+void test_external_clock_follows_transport_messages() {
+    ExternalClock clk;
+    uint64_t now = 0;
+    for (int i = 0; i < 8; ++i, now += PULSE_US_120_BPM) clk.pulse(now);
+    TEST_ASSERT_TRUE(clk.isLocked());
+    TEST_ASSERT_FALSE(clk.isPlaying());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 120.0f, clk.bpm());
+
+    // Start waits for the next pulse, which is tick 0.
+    clk.start();
+    clk.updateUs(now - 1);
+    TEST_ASSERT_FALSE(clk.isPlaying());
+    clk.pulse(now);
+    TEST_ASSERT_TRUE(clk.isPlaying());
+    TEST_ASSERT_EQUAL_UINT32(0, clk.tick());
+
+    // Between pulses the tick is interpolated on the smoothed period.
+    clk.updateUs(now + PULSE_US_120_BPM / 2);
+    TEST_ASSERT_EQUAL_UINT32(0, clk.tick());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, clk.tickPhase());
+
+    now += PULSE_US_120_BPM;
+    clk.pulse(now);
+    TEST_ASSERT_EQUAL_UINT32(1, clk.tick());
+
+    // Missing pulses: the clock runs at most one tick ahead of the last one.
+    clk.updateUs(now + 10 * PULSE_US_120_BPM);
+    TEST_ASSERT_EQUAL_UINT32(2, clk.tick());
+
+    clk.stop();
+    TEST_ASSERT_FALSE(clk.isPlaying());
+    now += PULSE_US_120_BPM;
+    clk.pulse(now);
+    TEST_ASSERT_EQUAL_UINT32(2, clk.tick());
+
+    // Continue resumes on the tick after the one Stop left off at.
+    clk.continuePlayback();
+    now += PULSE_US_120_BPM;
+    clk.pulse(now);
+    TEST_ASSERT_TRUE(clk.isPlaying());
+    TEST_ASSERT_EQUAL_UINT32(3, clk.tick());
+}
+
+void test_external_clock_interpolates_high_resolution_ticks() {
+    ExternalClock clk;
+    clk.setTicksPerQuarter(960);
+    uint64_t now = 0;
+    for (int i = 0; i < 8; ++i, now += PULSE_US_120_BPM) clk.pulse(now);
+
+    clk.start();
+    clk.pulse(now);
+    TEST_ASSERT_EQUAL_UINT32(0, clk.tick());
+    clk.updateUs(now + PULSE_US_120_BPM / 4 + 10);
+    TEST_ASSERT_EQUAL_UINT32(10, clk.tick());
+
+    now += PULSE_US_120_BPM;
+    clk.pulse(now);
+    TEST_ASSERT_EQUAL_UINT32(40, clk.tick());
+
+    clk.stop();
+    clk.continuePlayback();
+    now += PULSE_US_120_BPM;
+    clk.pulse(now);
+    TEST_ASSERT_EQUAL_UINT32(80, clk.tick());
+}
+
+void test_external_clock_leads_last_pulse_by_at_most_one_pulse() {
+    ExternalClock clk;
+    clk.setTicksPerQuarter(960);
+    uint64_t now = 0;
+    for (int i = 0; i < 8; ++i, now += PULSE_US_120_BPM) clk.pulse(now);
+
+    // Pulses stop half way through the second beat.
+    clk.start();
+    for (int i = 0; i < 36; ++i, now += PULSE_US_120_BPM) clk.pulse(now);
+    const uint32_t lastPulseTick = 35U * 40U;
+
+    uint32_t maxTick = 0;
+    for (uint64_t t = now - PULSE_US_120_BPM; t < now + 3U * PULSE_US_120_BPM; t += 100) {
+        clk.updateUs(t);
+        if (clk.tick() > maxTick) maxTick = clk.tick();
+    }
+    TEST_ASSERT_EQUAL_UINT32(lastPulseTick + 40U, maxTick);
+    TEST_ASSERT_EQUAL_UINT32(lastPulseTick + 40U, clk.tick());
+}
+
+void test_external_clock_smooths_jitter_and_tracks_tempo_changes() {
+    ExternalClock clk;
+    JitterSource jitter;
+    uint64_t ideal = 0;
+    for (int i = 0; i < 2000; ++i) {
+        ideal += PULSE_US_120_BPM;
+        clk.pulse(static_cast<uint64_t>(static_cast<int64_t>(ideal) + jitter.next(2'000)));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 120.0f, clk.bpm());
+
+    // 140 BPM: 17857us per pulse.
+    for (int i = 0; i < 2000; ++i) {
+        ideal += 17'857;
+        clk.pulse(static_cast<uint64_t>(static_cast<int64_t>(ideal) + jitter.next(2'000)));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 140.0f, clk.bpm());
+}
+
+void test_engine_on_external_clock_has_less_jitter_than_pulse_counting() {
+    const uint64_t counted = maxNoteOnDeviationUs(false);
+    const uint64_t followed = maxNoteOnDeviationUs(true);
+    TEST_ASSERT_TRUE(counted > 1'500);
+    TEST_ASSERT_TRUE(followed * 2U < counted);
+}
+
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_internal_clock_stopped_does_not_advance);
     RUN_TEST(test_internal_clock_resets_on_start);
+    RUN_TEST(test_internal_clock_us_input_carries_sub_tick_phase);
+    RUN_TEST(test_internal_clock_tick_phase_tracks_position_in_tick);
+    RUN_TEST(test_internal_clock_high_resolution_derives_midi_clock);
+    RUN_TEST(test_external_clock_follows_transport_messages);
+    RUN_TEST(test_external_clock_interpolates_high_resolution_ticks);
+    RUN_TEST(test_external_clock_leads_last_pulse_by_at_most_one_pulse);
+    RUN_TEST(test_external_clock_smooths_jitter_and_tracks_tempo_changes);
+    RUN_TEST(test_engine_on_external_clock_has_less_jitter_than_pulse_counting);
     return UNITY_END();
 }
@@ -1,13 +1,23 @@
 #include <unity.h>
 
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <vector>
 
+#include <oc/note/sequencer/SequencerConfig.hpp>
 #include <oc/note/sequencer/SequencerEvent.hpp>
 #include <oc/note/sequencer/StepSequencerEngine.hpp>
 #include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
 
+using oc::note::sequencer::AudioBlockTiming;
+using oc::note::sequencer::BasicNoteScheduler;
+using oc::note::sequencer::BasicStepSequencerEngine;
+using oc::note::sequencer::BasicStepSequencerRuntimeState;
+using oc::note::sequencer::DrumLaneSequencerConfig;
 using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::NoteScheduler;
+using oc::note::sequencer::OverflowPolicy;
 using oc::note::sequencer::SequencerEvent;
 using oc::note::sequencer::SequencerEventType;
 using oc::note::sequencer::StepSequencerEngine;
@@ -26,6 +36,24 @@ public:
     }
 };
 
+/// Concrete sink with no virtual interface, for the statically dispatched engine.
+class DirectEventSink final {
+public:
+    std::vector<SequencerEvent> events;
+    int batches = 0;
+
+    bool emitSequencerEvent(const SequencerEvent& event) {
+        events.push_back(event);
+        return true;
+    }
+
+    size_t emitSequencerEvents(const SequencerEvent* batch, size_t count) {
+        ++batches;
+        events.insert(events.end(), batch, batch + count);
+        return count;
+    }
+};
+
 int countType(const std::vector<SequencerEvent>& events, SequencerEventType type) {
     int count = 0;
     for (const auto& e : events) {
@@ -108,6 +136,31 @@ void test_note_off_follows_gate_percent() {
     TEST_ASSERT_EQUAL_UINT8(0, sink.events[1].velocity);
 }
 
+void test_gate_is_clamped_to_max_percent() {
+    StepSequencerRuntimeState st;
+    st.length = 8;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::fromLower64(0x3ULL);
+    st.setGate(0, 255);
+    TEST_ASSERT_EQUAL_UINT16(StepSequencerRuntimeState::MAX_GATE_PERCENT, st.gate[0]);
+    st.gate[1] = 400;
+    st.note[1] = 62;
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    for (uint32_t tick = 0; tick < 40; ++tick) {
+        eng.update(tick, true);
+    }
+
+    std::vector<uint32_t> offTicks;
+    for (const auto& e : sink.events) {
+        if (e.type == SequencerEventType::NoteOff) offTicks.push_back(e.tick);
+    }
+    TEST_ASSERT_EQUAL(2, static_cast<int>(offTicks.size()));
+    TEST_ASSERT_EQUAL_UINT32(12, offTicks[0]);
+    TEST_ASSERT_EQUAL_UINT32(18, offTicks[1]);
+}
+
 void test_boundary_order_note_off_before_next_step() {
     StepSequencerRuntimeState st;
     st.length = 2;
@@ -267,15 +320,759 @@ void test_stop_calls_all_notes_off_once() {
     TEST_ASSERT_EQUAL(1, countType(sink.events, SequencerEventType::AllNotesOff));
 }
 
+namespace {
+
+template <typename State>
+void fillRenderPattern(State& st) {
+    st.length = 16;
+    st.stepsPerBeat = 4;
+    st.enabledMask = State::StepMask::fromLower64(0xB6D5);
+    for (uint8_t i = 0; i < 16; ++i) {
+        st.note[i] = static_cast<uint8_t>(48 + i);
+        st.gate[i] = static_cast<uint16_t>(30 + i * 10);
+        st.nudge[i] = static_cast<int8_t>((i % 3) * 25 - 25);
+        st.probability[i] = static_cast<uint8_t>((i % 4 == 0) ? 100 : 60);
+    }
+}
+
+}  // namespace
+
+void test_render_range_matches_per_tick_updates() {
+    StepSequencerRuntimeState liveState;
+    StepSequencerRuntimeState renderState;
+    fillRenderPattern(liveState);
+    fillRenderPattern(renderState);
+
+    MockEventSink liveSink;
+    StepSequencerEngine live(liveState, liveSink);
+    MockEventSink unusedSink;
+    StepSequencerEngine render(renderState, unusedSink);
+
+    std::vector<SequencerEvent> rendered;
+    std::array<SequencerEvent, 64> block{};
+    for (uint32_t from = 0; from < 960; from += 32) {
+        for (uint32_t tick = from; tick < from + 32; ++tick) {
+            live.update(tick, true);
+        }
+        const auto result = render.renderRange(from, from + 32, block.data(), block.size());
+        TEST_ASSERT_TRUE(result.complete);
+        rendered.insert(rendered.end(), block.begin(), block.begin() + result.eventCount);
+        TEST_ASSERT_EQUAL(liveState.playheadStep, renderState.playheadStep);
+    }
+
+    TEST_ASSERT_EQUAL(0, static_cast<int>(unusedSink.events.size()));
+    TEST_ASSERT_EQUAL(static_cast<int>(liveSink.events.size()), static_cast<int>(rendered.size()));
+    for (size_t i = 0; i < rendered.size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT32(liveSink.events[i].tick, rendered[i].tick);
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(liveSink.events[i].type), static_cast<uint8_t>(rendered[i].type));
+        TEST_ASSERT_EQUAL_UINT8(liveSink.events[i].note, rendered[i].note);
+    }
+}
+
+void test_render_range_resumes_when_buffer_fills() {
+    StepSequencerRuntimeState fullState;
+    StepSequencerRuntimeState chunkedState;
+    fillRenderPattern(fullState);
+    fillRenderPattern(chunkedState);
+
+    MockEventSink sink;
+    StepSequencerEngine full(fullState, sink);
+    StepSequencerEngine chunked(chunkedState, sink);
+
+    std::array<SequencerEvent, 256> expected{};
+    const auto fullResult = full.renderRange(0, 384, expected.data(), expected.size());
+    TEST_ASSERT_TRUE(fullResult.complete);
+    TEST_ASSERT_TRUE(fullResult.eventCount > 3);
+
+    std::vector<SequencerEvent> rendered;
+    std::array<SequencerEvent, 3> block{};
+    for (int guard = 0; guard < 1000; ++guard) {
+        const auto result = chunked.renderRange(0, 384, block.data(), block.size());
+        rendered.insert(rendered.end(), block.begin(), block.begin() + result.eventCount);
+        if (result.complete) break;
+        TEST_ASSERT_EQUAL(3, static_cast<int>(result.eventCount));
+    }
+
+    TEST_ASSERT_EQUAL(0, countType(rendered, SequencerEventType::AllNotesOff));
+    TEST_ASSERT_EQUAL(static_cast<int>(fullResult.eventCount), static_cast<int>(rendered.size()));
+    for (size_t i = 0; i < rendered.size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i].tick, rendered[i].tick);
+        TEST_ASSERT_EQUAL_UINT8(expected[i].note, rendered[i].note);
+    }
+    TEST_ASSERT_EQUAL(0, static_cast<int>(sink.events.size()));
+}
+
+void test_static_sink_engine_matches_virtual_sink_engine() {
+    StepSequencerRuntimeState virtualState;
+    StepSequencerRuntimeState directState;
+    fillRenderPattern(virtualState);
+    fillRenderPattern(directState);
+
+    MockEventSink virtualSink;
+    StepSequencerEngine virtualEngine(virtualState, virtualSink);
+    DirectEventSink directSink;
+    BasicStepSequencerEngine<DirectEventSink> directEngine(directState, directSink);
+
+    for (uint32_t tick = 0; tick < 500; tick += 5) {
+        virtualEngine.update(tick, true);
+        directEngine.update(tick, true);
+    }
+    virtualEngine.update(500, false);
+    directEngine.update(500, false);
+
+    TEST_ASSERT_TRUE(directSink.batches > 0);
+    TEST_ASSERT_EQUAL(static_cast<int>(virtualSink.events.size()), static_cast<int>(directSink.events.size()));
+    for (size_t i = 0; i < directSink.events.size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT32(virtualSink.events[i].tick, directSink.events[i].tick);
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(virtualSink.events[i].type), static_cast<uint8_t>(directSink.events[i].type));
+        TEST_ASSERT_EQUAL_UINT8(virtualSink.events[i].note, directSink.events[i].note);
+    }
+}
+
+void test_sixteen_step_state_matches_default_state() {
+    using LaneState = BasicStepSequencerRuntimeState<DrumLaneSequencerConfig>;
+    StepSequencerRuntimeState wideState;
+    LaneState laneState;
+    fillRenderPattern(wideState);
+    fillRenderPattern(laneState);
+    const uint8_t chordNotes[2] = {67, 70};
+    const uint8_t chordVelocities[2] = {90, 80};
+    TEST_ASSERT_TRUE(wideState.setChord(2, chordNotes, chordVelocities, 2));
+    TEST_ASSERT_TRUE(laneState.setChord(2, chordNotes, chordVelocities, 2));
+
+    MockEventSink wideSink;
+    StepSequencerEngine wide(wideState, wideSink);
+    MockEventSink laneSink;
+    using LaneEngine = BasicStepSequencerEngine<ISequencerEventSink, NoteScheduler, LaneState>;
+    LaneEngine lane(laneState, laneSink);
+    for (uint32_t tick = 0; tick < 600; ++tick) {
+        if (tick == 300) {
+            wideState.setNote(5, 40);
+            laneState.setNote(5, 40);
+        }
+        wide.update(tick, true);
+        lane.update(tick, true);
+    }
+    wide.update(600, false);
+    lane.update(600, false);
+
+    TEST_ASSERT_TRUE(laneSink.events.size() > 50);
+    TEST_ASSERT_EQUAL(static_cast<int>(wideSink.events.size()), static_cast<int>(laneSink.events.size()));
+    for (size_t i = 0; i < laneSink.events.size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT32(wideSink.events[i].tick, laneSink.events[i].tick);
+        TEST_ASSERT_TRUE(wideSink.events[i].type == laneSink.events[i].type);
+        TEST_ASSERT_EQUAL_UINT8(wideSink.events[i].note, laneSink.events[i].note);
+    }
+    TEST_ASSERT_TRUE(sizeof(LaneState) * 3 < sizeof(StepSequencerRuntimeState));
+    // The scheduler is the same size; the compiled step table drops the 112 missing steps.
+    TEST_ASSERT_TRUE(sizeof(wide) - sizeof(lane) >= 112U * sizeof(oc::note::sequencer::CompiledStep));
+}
+
+template <OverflowPolicy Policy>
+std::vector<SequencerEvent> playWithFourSlotScheduler(uint32_t ticks) {
+    StepSequencerRuntimeState st;
+    st.length = 8;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(8);
+    for (uint8_t i = 0; i < 8; ++i) {
+        st.note[i] = static_cast<uint8_t>(60 + i);
+        st.velocity[i] = 100;
+        st.gate[i] = 200;
+    }
+
+    MockEventSink sink;
+    BasicStepSequencerEngine<ISequencerEventSink, BasicNoteScheduler<4, Policy>> eng(st, sink);
+    for (uint32_t tick = 0; tick < ticks; ++tick) {
+        eng.update(tick, true);
+    }
+    return sink.events;
+}
+
+void test_small_scheduler_overflow_policy_keeps_notes_playing() {
+    const auto legacy = playWithFourSlotScheduler<OverflowPolicy::ClearAll>(96);
+    TEST_ASSERT_TRUE(countType(legacy, SequencerEventType::AllNotesOff) > 0);
+
+    const auto events = playWithFourSlotScheduler<OverflowPolicy::StealOldestNoteOn>(96);
+    TEST_ASSERT_EQUAL(0, countType(events, SequencerEventType::AllNotesOff));
+    TEST_ASSERT_TRUE(countType(events, SequencerEventType::NoteOn) >= 4);
+
+    // Every NoteOn that had time to finish got its NoteOff.
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (events[i].type != SequencerEventType::NoteOn || events[i].tick + 12U >= 96U) continue;
+        bool released = false;
+        for (size_t j = i + 1; j < events.size() && !released; ++j) {
+            released = events[j].type == SequencerEventType::NoteOff && events[j].note == events[i].note;
+        }
+        TEST_ASSERT_TRUE(released);
+    }
+}
+
+void test_render_range_keeps_all_notes_off_that_did_not_fit() {
+    const auto expected = playWithFourSlotScheduler<OverflowPolicy::ClearAll>(96);
+    TEST_ASSERT_TRUE(countType(expected, SequencerEventType::AllNotesOff) > 0);
+
+    StepSequencerRuntimeState st;
+    st.length = 8;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(8);
+    for (uint8_t i = 0; i < 8; ++i) {
+        st.note[i] = static_cast<uint8_t>(60 + i);
+        st.velocity[i] = 100;
+        st.gate[i] = 200;
+    }
+    using FourSlotScheduler = BasicNoteScheduler<4, OverflowPolicy::ClearAll>;
+    MockEventSink sink;
+    BasicStepSequencerEngine<ISequencerEventSink, FourSlotScheduler> eng(st, sink);
+
+    // One slot per call, so every AllNotesOff meets a full buffer.
+    std::vector<SequencerEvent> rendered;
+    std::array<SequencerEvent, 1> block{};
+    for (uint32_t from = 0; from < 96; from += 8) {
+        for (int guard = 0; guard < 100; ++guard) {
+            const auto result = eng.renderRange(from, from + 8, block.data(), block.size());
+            rendered.insert(rendered.end(), block.begin(), block.begin() + result.eventCount);
+            if (result.complete) break;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(static_cast<int>(expected.size()), static_cast<int>(rendered.size()));
+    for (size_t i = 0; i < rendered.size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i].tick, rendered[i].tick);
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(expected[i].type), static_cast<uint8_t>(rendered[i].type));
+        TEST_ASSERT_EQUAL_UINT8(expected[i].note, rendered[i].note);
+    }
+}
+
+void test_render_range_past_last_tick_jumps_to_from_tick() {
+    StepSequencerRuntimeState renderState;
+    StepSequencerRuntimeState liveState;
+    for (StepSequencerRuntimeState* st : {&renderState, &liveState}) {
+        st->length = 4;
+        st->stepsPerBeat = 4;
+        st->enabledMask = StepBitMask128::prefixMask(4);
+        for (uint8_t i = 0; i < 4; ++i) {
+            st->note[i] = static_cast<uint8_t>(60 + i);
+            st->gate[i] = 150;
+        }
+    }
+    MockEventSink unusedSink;
+    StepSequencerEngine render(renderState, unusedSink);
+    MockEventSink liveSink;
+    StepSequencerEngine live(liveState, liveSink);
+
+    std::array<SequencerEvent, 64> block{};
+    TEST_ASSERT_TRUE(render.renderRange(0, 32, block.data(), block.size()).complete);
+    for (uint32_t tick = 0; tick < 32; ++tick) {
+        live.update(tick, true);
+    }
+    liveSink.events.clear();
+    live.resyncToTick(64);
+    for (uint32_t tick = 64; tick < 96; ++tick) {
+        live.update(tick, true);
+    }
+
+    const auto result = render.renderRange(64, 96, block.data(), block.size());
+    TEST_ASSERT_TRUE(result.complete);
+    TEST_ASSERT_EQUAL(static_cast<int>(liveSink.events.size()), static_cast<int>(result.eventCount));
+    TEST_ASSERT_TRUE(block[0].type == SequencerEventType::AllNotesOff);
+    for (size_t i = 0; i < result.eventCount; ++i) {
+        TEST_ASSERT_TRUE(block[i].tick >= 64);
+        TEST_ASSERT_EQUAL_UINT32(liveSink.events[i].tick, block[i].tick);
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(liveSink.events[i].type), static_cast<uint8_t>(block[i].type));
+        TEST_ASSERT_EQUAL_UINT8(liveSink.events[i].note, block[i].note);
+    }
+    TEST_ASSERT_EQUAL(liveState.playheadStep, renderState.playheadStep);
+
+    // A first window past zero starts there, with nothing before it and nothing to silence.
+    StepSequencerEngine fresh(liveState, unusedSink);
+    const auto first = fresh.renderRange(40, 64, block.data(), block.size());
+    TEST_ASSERT_TRUE(first.complete);
+    TEST_ASSERT_TRUE(first.eventCount > 0);
+    for (size_t i = 0; i < first.eventCount; ++i) {
+        TEST_ASSERT_TRUE(block[i].tick >= 40);
+        TEST_ASSERT_TRUE(block[i].type != SequencerEventType::AllNotesOff);
+    }
+}
+
+void test_render_range_before_last_tick_jumps_back_to_from_tick() {
+    StepSequencerRuntimeState renderState;
+    StepSequencerRuntimeState liveState;
+    for (StepSequencerRuntimeState* st : {&renderState, &liveState}) {
+        st->length = 4;
+        st->stepsPerBeat = 4;
+        st->enabledMask = StepBitMask128::prefixMask(4);
+        for (uint8_t i = 0; i < 4; ++i) {
+            st->note[i] = static_cast<uint8_t>(60 + i);
+            st->gate[i] = 150;
+        }
+    }
+    MockEventSink unusedSink;
+    StepSequencerEngine render(renderState, unusedSink);
+    MockEventSink liveSink;
+    StepSequencerEngine live(liveState, liveSink);
+
+    // The note starting at tick 474 is still sounding when the first window ends.
+    std::vector<SequencerEvent> block(512);
+    const auto played = render.renderRange(0, 480, block.data(), block.size());
+    TEST_ASSERT_TRUE(played.complete);
+    bool held = false;
+    for (size_t i = 0; i < played.eventCount; ++i) {
+        if (block[i].type == SequencerEventType::NoteOn && block[i].tick == 474) held = true;
+        const bool releases63 = block[i].type == SequencerEventType::NoteOff && block[i].note == 63;
+        if (releases63 && block[i].tick > 474) held = false;
+    }
+    TEST_ASSERT_TRUE(held);
+
+    for (uint32_t tick = 0; tick < 480; ++tick) {
+        live.update(tick, true);
+    }
+    liveSink.events.clear();
+    live.resyncToTick(240);
+    for (uint32_t tick = 240; tick < 264; ++tick) {
+        live.update(tick, true);
+    }
+
+    const auto result = render.renderRange(240, 264, block.data(), block.size());
+    TEST_ASSERT_TRUE(result.complete);
+    TEST_ASSERT_TRUE(block[0].type == SequencerEventType::AllNotesOff);
+    TEST_ASSERT_EQUAL(static_cast<int>(liveSink.events.size()), static_cast<int>(result.eventCount));
+    for (size_t i = 0; i < result.eventCount; ++i) {
+        TEST_ASSERT_TRUE(block[i].tick >= 240 && block[i].tick < 264);
+        TEST_ASSERT_EQUAL_UINT32(liveSink.events[i].tick, block[i].tick);
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(liveSink.events[i].type), static_cast<uint8_t>(block[i].type));
+        TEST_ASSERT_EQUAL_UINT8(liveSink.events[i].note, block[i].note);
+    }
+
+    // Driving update backwards releases held notes the same way.
+    liveSink.events.clear();
+    live.update(12, true);
+    TEST_ASSERT_TRUE(liveSink.events.front().type == SequencerEventType::AllNotesOff);
+}
+
+void test_resync_chases_note_held_across_seek_point() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::fromLower64(0b0011);
+    st.note[0] = 60;
+    st.velocity[0] = 90;
+    st.gate[0] = 200;  // 0..12
+    st.note[1] = 62;
+    st.velocity[1] = 80;
+    st.gate[1] = 100;
+    st.nudge[1] = 50;  // 9..15
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    eng.update(0, true);
+
+    sink.events.clear();
+    eng.resyncToTick(7);
+    TEST_ASSERT_EQUAL(1, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::AllNotesOff), static_cast<int>(sink.events[0].type));
+
+    for (uint32_t tick = 7; tick <= 15; ++tick) {
+        eng.update(tick, true);
+    }
+
+    TEST_ASSERT_EQUAL(5, static_cast<int>(sink.events.size()));
+    // Held note re-sounds at the seek point and keeps its original release.
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[1].note);
+    TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::NoteOn), static_cast<int>(sink.events[1].type));
+    TEST_ASSERT_EQUAL_UINT32(7, sink.events[1].tick);
+    TEST_ASSERT_EQUAL_UINT8(90, sink.events[1].velocity);
+    // Step 1 is nudged past the seek point, so it starts on its own tick.
+    TEST_ASSERT_EQUAL_UINT8(62, sink.events[2].note);
+    TEST_ASSERT_EQUAL_UINT32(9, sink.events[2].tick);
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[3].note);
+    TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::NoteOff), static_cast<int>(sink.events[3].type));
+    TEST_ASSERT_EQUAL_UINT32(12, sink.events[3].tick);
+    TEST_ASSERT_EQUAL_UINT8(62, sink.events[4].note);
+    TEST_ASSERT_EQUAL_UINT32(15, sink.events[4].tick);
+
+    // Past every release: nothing is chased.
+    sink.events.clear();
+    eng.resyncToTick(16);
+    eng.update(16, true);
+    TEST_ASSERT_EQUAL(1, static_cast<int>(sink.events.size()));
+}
+
+void test_resync_jumps_to_distant_probability_cycle() {
+    StepSequencerRuntimeState liveState;
+    StepSequencerRuntimeState seekState;
+    for (auto* st : {&liveState, &seekState}) {
+        st->length = 8;
+        st->stepsPerBeat = 4;
+        st->enabledMask = StepBitMask128::prefixMask(8);
+        for (uint8_t i = 0; i < 8; ++i) {
+            st->note[i] = static_cast<uint8_t>(60 + i);
+            st->gate[i] = 50;
+            st->probability[i] = 50;
+        }
+    }
+
+    MockEventSink liveSink;
+    MockEventSink seekSink;
+    StepSequencerEngine live(liveState, liveSink);
+    StepSequencerEngine seek(seekState, seekSink);
+
+    const uint32_t target = 6U * 8U * 1000U;
+    for (uint32_t tick = 0; tick < target + 96U; ++tick) {
+        live.update(tick, true);
+    }
+
+    seek.update(0, true);
+    seek.resyncToTick(target);
+    seekSink.events.clear();
+    for (uint32_t tick = target; tick < target + 96U; ++tick) {
+        seek.update(tick, true);
+    }
+
+    std::vector<SequencerEvent> expected;
+    for (const auto& e : liveSink.events) {
+        if (e.tick >= target) expected.push_back(e);
+    }
+    TEST_ASSERT_TRUE(expected.size() > 4);
+    TEST_ASSERT_EQUAL(static_cast<int>(expected.size()), static_cast<int>(seekSink.events.size()));
+    for (size_t i = 0; i < expected.size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i].tick, seekSink.events[i].tick);
+        TEST_ASSERT_EQUAL_UINT8(expected[i].note, seekSink.events[i].note);
+    }
+    TEST_ASSERT_EQUAL_UINT32(liveState.probabilityCycleIndex, seekState.probabilityCycleIndex);
+    TEST_ASSERT_TRUE(liveState.probabilityCycleMask == seekState.probabilityCycleMask);
+}
+
+void test_step_edits_apply_after_mark_step_data_changed() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(4);
+    for (uint8_t i = 0; i < 4; ++i) {
+        st.note[i] = 60;
+        st.velocity[i] = 100;
+        st.gate[i] = 50;
+    }
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    eng.update(0, true);
+
+    // Step 3 (tick 18) is not scheduled yet; the edit must reach it.
+    st.note[3] = 72;
+    st.nudge[3] = 50;
+    st.markStepDataChanged();
+    st.midiChannel = 20;
+
+    for (uint32_t tick = 1; tick < 24; ++tick) {
+        eng.update(tick, true);
+    }
+
+    const SequencerEvent* step3 = nullptr;
+    for (const auto& e : sink.events) {
+        if (e.type == SequencerEventType::NoteOn && e.note == 72) step3 = &e;
+    }
+    TEST_ASSERT_NOT_NULL(step3);
+    TEST_ASSERT_EQUAL_UINT32(21, step3->tick);
+    TEST_ASSERT_EQUAL_UINT8(15, step3->channel);
+}
+
+void test_direct_array_writes_reach_a_playing_pattern() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(4);
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    for (uint32_t tick = 0; tick < 10; ++tick) {
+        eng.update(tick, true);
+    }
+
+    // No setter and no markStepDataChanged(): steps not yet queued still pick it up.
+    for (uint8_t i = 0; i < 4; ++i) {
+        st.note[i] = 60;
+    }
+    st.gate[1] = 50;
+
+    for (uint32_t tick = 10; tick < 60; ++tick) {
+        eng.update(tick, true);
+    }
+
+    int edited = 0;
+    for (const auto& e : sink.events) {
+        if (e.type != SequencerEventType::NoteOn) continue;
+        if (e.tick < 10) {
+            TEST_ASSERT_EQUAL_UINT8(StepSequencerRuntimeState::DEFAULT_NOTE, e.note);
+        } else if (e.tick >= 24) {
+            TEST_ASSERT_EQUAL_UINT8(60, e.note);
+            ++edited;
+        }
+    }
+    TEST_ASSERT_EQUAL(6, edited);
+
+    bool shortGate = false;
+    for (const auto& e : sink.events) {
+        if (e.type == SequencerEventType::NoteOff && e.note == 60 && e.tick == 33) shortGate = true;
+    }
+    TEST_ASSERT_TRUE(shortGate);
+}
+
+void test_step_setters_reschedule_only_dirty_steps() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(4);
+    for (uint8_t i = 0; i < 4; ++i) {
+        st.note[i] = static_cast<uint8_t>(60 + i);
+        st.velocity[i] = 100;
+        st.gate[i] = 50;
+    }
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    for (uint32_t tick = 0; tick <= 7; ++tick) {
+        eng.update(tick, true);
+    }
+    sink.events.clear();
+    const uint32_t generation = st.generation;
+
+    // Steps 2 and 3 are already queued; step 1 is sounding.
+    st.setProbability(2, 0);
+    st.setGate(3, 150);
+    st.setNote(1, 72);
+    st.setNote(0, 60);
+    TEST_ASSERT_EQUAL_UINT32(generation + 3U, st.generation);
+    TEST_ASSERT_TRUE(st.dirtySteps == StepBitMask128::fromLower64(0xEULL));
+
+    for (uint32_t tick = 8; tick <= 30; ++tick) {
+        eng.update(tick, true);
+    }
+    TEST_ASSERT_FALSE(st.dirtySteps.any());
+    TEST_ASSERT_FALSE(st.probabilityCycleMask.test(2));
+
+    bool releasedOld = false;
+    bool releasedLong = false;
+    bool playedEdited = false;
+    for (const auto& e : sink.events) {
+        TEST_ASSERT_FALSE(e.type == SequencerEventType::NoteOn && e.note == 62);
+        if (e.type == SequencerEventType::NoteOff && e.note == 61 && e.tick == 9) releasedOld = true;
+        if (e.type == SequencerEventType::NoteOff && e.note == 63 && e.tick == 27) releasedLong = true;
+        if (e.type == SequencerEventType::NoteOn && e.note == 72 && e.tick == 30) playedEdited = true;
+    }
+    TEST_ASSERT_TRUE(releasedOld);
+    TEST_ASSERT_TRUE(releasedLong);
+    TEST_ASSERT_TRUE(playedEdited);
+    TEST_ASSERT_EQUAL(3, countType(sink.events, SequencerEventType::NoteOn));
+    TEST_ASSERT_EQUAL(3, countType(sink.events, SequencerEventType::NoteOff));
+}
+
+void test_edit_keeps_release_of_long_note_from_previous_cycle() {
+    StepSequencerRuntimeState st;
+    st.length = 1;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(1);
+    st.note[0] = 60;
+    st.gate[0] = 200;
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    eng.update(0, true);
+
+    // The note from tick 0 holds until 12; the queued ones now end sooner.
+    st.setGate(0, 25);
+    eng.update(1, true);
+    // A second edit cancels those short notes again; the long one keeps its release.
+    st.setVelocity(0, 90);
+    for (uint32_t tick = 2; tick <= 14; ++tick) {
+        eng.update(tick, true);
+    }
+
+    std::vector<uint32_t> offTicks;
+    for (const auto& e : sink.events) {
+        if (e.type == SequencerEventType::NoteOff) offTicks.push_back(e.tick);
+    }
+    TEST_ASSERT_EQUAL(3, static_cast<int>(offTicks.size()));
+    TEST_ASSERT_EQUAL_UINT32(7, offTicks[0]);
+    TEST_ASSERT_EQUAL_UINT32(12, offTicks[1]);
+    TEST_ASSERT_EQUAL_UINT32(13, offTicks[2]);
+}
+
+void test_high_resolution_ticks_keep_fine_nudge_and_gate() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::fromLower64(1ULL << 1);
+    st.nudge[1] = 3;
+    st.gate[1] = 5;
+
+    // 24 PPQN: a 6-tick step rounds the nudge away and the gate up to a tick.
+    MockEventSink coarseSink;
+    StepSequencerEngine coarse(st, coarseSink);
+    for (uint32_t tick = 0; tick < 12; ++tick) coarse.update(tick, true);
+    TEST_ASSERT_EQUAL(2, static_cast<int>(coarseSink.events.size()));
+    TEST_ASSERT_EQUAL_UINT32(6, coarseSink.events[0].tick);
+    TEST_ASSERT_EQUAL_UINT32(7, coarseSink.events[1].tick);
+
+    // 960 PPQN: 240-tick steps, +3% = 7 ticks, 5% gate = 12 ticks.
+    MockEventSink fineSink;
+    StepSequencerEngine fine(st, fineSink);
+    fine.setTicksPerQuarter(960);
+    TEST_ASSERT_EQUAL_UINT16(960, fine.ticksPerQuarter());
+    for (uint32_t tick = 0; tick < 480; ++tick) fine.update(tick, true);
+    TEST_ASSERT_EQUAL(2, static_cast<int>(fineSink.events.size()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::NoteOn), static_cast<int>(fineSink.events[0].type));
+    TEST_ASSERT_EQUAL_UINT32(247, fineSink.events[0].tick);
+    TEST_ASSERT_EQUAL_UINT32(259, fineSink.events[1].tick);
+
+    // Resolutions that are not a multiple of the MIDI clock are rounded down.
+    fine.setTicksPerQuarter(100);
+    TEST_ASSERT_EQUAL_UINT16(96, fine.ticksPerQuarter());
+}
+
+/// Drives `renderBlock` over consecutive blocks and returns each event's absolute sample.
+std::vector<uint64_t> renderBlocksToSamples(StepSequencerEngine& eng,
+                                            float sampleRate,
+                                            float bpm,
+                                            uint32_t blockSize,
+                                            uint32_t blocks,
+                                            std::vector<SequencerEvent>& events) {
+    const double samplesPerTick = sampleRate * 60.0 / (bpm * eng.ticksPerQuarter());
+    std::vector<uint64_t> samples;
+    std::array<SequencerEvent, 16> out{};
+    std::array<uint32_t, 16> offsets{};
+    for (uint32_t b = 0; b < blocks; ++b) {
+        const double position = static_cast<double>(b) * blockSize / samplesPerTick;
+        AudioBlockTiming block;
+        block.startTick = static_cast<uint32_t>(position);
+        block.startTickPhase = static_cast<float>(position - block.startTick);
+        block.sampleRate = sampleRate;
+        block.blockSize = blockSize;
+        block.bpm = bpm;
+
+        const auto result = eng.renderBlock(block, out.data(), offsets.data(), out.size());
+        TEST_ASSERT_TRUE(result.complete);
+        for (size_t i = 0; i < result.eventCount; ++i) {
+            TEST_ASSERT_TRUE(offsets[i] < blockSize);
+            events.push_back(out[i]);
+            samples.push_back(static_cast<uint64_t>(b) * blockSize + offsets[i]);
+        }
+    }
+    return samples;
+}
+
+void test_render_block_places_events_on_exact_samples() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(4);
+
+    // 48 kHz at 120 BPM: 1000 samples per 24-PPQN tick; 256-sample blocks never align.
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    std::vector<SequencerEvent> events;
+    const auto samples = renderBlocksToSamples(eng, 48'000.0f, 120.0f, 256, 200, events);
+
+    TEST_ASSERT_EQUAL(0, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL(17, static_cast<int>(events.size()));
+    for (size_t i = 0; i < events.size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT64(static_cast<uint64_t>(events[i].tick) * 1000U, samples[i]);
+    }
+}
+
+void test_render_block_stays_within_a_sample_at_odd_rates() {
+    StepSequencerRuntimeState st;
+    st.length = 8;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(8);
+    st.nudge[3] = 7;
+    st.gate[5] = 33;
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    eng.setTicksPerQuarter(960);
+    std::vector<SequencerEvent> events;
+    const auto samples = renderBlocksToSamples(eng, 44'100.0f, 133.0f, 97, 2000, events);
+
+    const double samplesPerTick = 44'100.0 * 60.0 / (133.0 * 960.0);
+    TEST_ASSERT_TRUE(events.size() > 60);
+    for (size_t i = 0; i < events.size(); ++i) {
+        const double exact = events[i].tick * samplesPerTick;
+        TEST_ASSERT_TRUE(std::fabs(static_cast<double>(samples[i]) - exact) <= 1.0);
+    }
+}
+
+void test_sparse_pattern_jumps_match_per_tick_updates() {
+    StepSequencerRuntimeState tickedState;
+    StepSequencerRuntimeState jumpedState;
+    for (StepSequencerRuntimeState* st : {&tickedState, &jumpedState}) {
+        st->length = 128;
+        st->enabledMask.setBit(0);
+        st->enabledMask.setBit(37);
+        st->enabledMask.setBit(127);
+        st->nudge[0] = -50;
+        st->gate[127] = 200;
+        st->probability[37] = 50;
+        st->note[0] = 36;
+        st->note[37] = 38;
+        st->note[127] = 42;
+    }
+
+    MockEventSink tickedSink;
+    StepSequencerEngine ticked(tickedState, tickedSink);
+    MockEventSink jumpedSink;
+    StepSequencerEngine jumped(jumpedState, jumpedSink);
+    ticked.setNextRunSeed(7);
+    jumped.setNextRunSeed(7);
+
+    const uint32_t jumps[] = {0, 1, 500, 501, 777, 2300, 2301, 2302, 6000, 6100, 9000};
+    uint32_t tick = 0;
+    for (const uint32_t target : jumps) {
+        for (; tick <= target; ++tick) {
+            ticked.update(tick, true);
+        }
+        jumped.update(target, true);
+        TEST_ASSERT_EQUAL(tickedState.playheadStep, jumpedState.playheadStep);
+        TEST_ASSERT_EQUAL_UINT32(tickedState.probabilityCycleIndex, jumpedState.probabilityCycleIndex);
+    }
+
+    TEST_ASSERT_TRUE(tickedSink.events.size() > 30);
+    TEST_ASSERT_EQUAL(static_cast<int>(tickedSink.events.size()), static_cast<int>(jumpedSink.events.size()));
+    for (size_t i = 0; i < tickedSink.events.size(); ++i) {
+        TEST_ASSERT_EQUAL_UINT32(tickedSink.events[i].tick, jumpedSink.events[i].tick);
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(tickedSink.events[i].type),
+                          static_cast<uint8_t>(jumpedSink.events[i].type));
+        TEST_ASSERT_EQUAL_UINT8(tickedSink.events[i].note, jumpedSink.events[i].note);
+    }
+}
+
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_gate_zero_mutes_note);
     RUN_TEST(test_velocity_zero_is_sent);
     RUN_TEST(test_note_off_follows_gate_percent);
+    RUN_TEST(test_gate_is_clamped_to_max_percent);
     RUN_TEST(test_boundary_order_note_off_before_next_step);
     RUN_TEST(test_positive_nudge_delays_note_on_and_note_off);
     RUN_TEST(test_negative_nudge_triggers_before_quantized_boundary);
     RUN_TEST(test_note_off_stays_before_next_note_on_when_nudged);
     RUN_TEST(test_stop_calls_all_notes_off_once);
+    RUN_TEST(test_render_range_matches_per_tick_updates);
+    RUN_TEST(test_render_range_resumes_when_buffer_fills);
+    RUN_TEST(test_static_sink_engine_matches_virtual_sink_engine);
+    RUN_TEST(test_sixteen_step_state_matches_default_state);
+    RUN_TEST(test_small_scheduler_overflow_policy_keeps_notes_playing);
+    RUN_TEST(test_render_range_keeps_all_notes_off_that_did_not_fit);
+    RUN_TEST(test_render_range_past_last_tick_jumps_to_from_tick);
+    RUN_TEST(test_render_range_before_last_tick_jumps_back_to_from_tick);
+    RUN_TEST(test_resync_chases_note_held_across_seek_point);
+    RUN_TEST(test_resync_jumps_to_distant_probability_cycle);
+    RUN_TEST(test_step_edits_apply_after_mark_step_data_changed);
+    RUN_TEST(test_direct_array_writes_reach_a_playing_pattern);
+    RUN_TEST(test_step_setters_reschedule_only_dirty_steps);
+    RUN_TEST(test_edit_keeps_release_of_long_note_from_previous_cycle);
+    RUN_TEST(test_high_resolution_ticks_keep_fine_nudge_and_gate);
+    RUN_TEST(test_render_block_places_events_on_exact_samples);
+    RUN_TEST(test_render_block_stays_within_a_sample_at_odd_rates);
+    RUN_TEST(test_sparse_pattern_jumps_match_per_tick_updates);
     return UNITY_END();
 }
@@ -0,0 +1,170 @@
+#include <unity.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+// The build links this test against a library compiled with the same flag (see CMakeLists.txt).
+#if !OC_NOTE_ENGINE_STATS
+#error "test_engine_stats must be built with OC_NOTE_ENGINE_STATS=1"
+#endif
+
+using oc::note::sequencer::BasicNoteScheduler;
+using oc::note::sequencer::BasicStepSequencerEngine;
+using oc::note::sequencer::OverflowPolicy;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+class StatsTestSink final {
+public:
+    bool accept = true;
+    int emitted = 0;
+
+    bool emitSequencerEvent(const SequencerEvent&) {
+        if (accept) ++emitted;
+        return accept;
+    }
+
+    size_t emitSequencerEvents(const SequencerEvent*, size_t count) {
+        if (!accept) return 0;
+        emitted += static_cast<int>(count);
+        return count;
+    }
+};
+
+using StatsEngine = BasicStepSequencerEngine<StatsTestSink>;
+
+uint32_t fake_cycles = 0;
+
+uint32_t fakeCycleCounter() {
+    fake_cycles += 7U;
+    return fake_cycles;
+}
+
+void fillPattern(StepSequencerRuntimeState& st) {
+    st.length = 8;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(8);
+    for (uint8_t i = 0; i < 8; ++i) {
+        st.note[i] = static_cast<uint8_t>(60 + i);
+        st.velocity[i] = 100;
+        st.gate[i] = 150;
+    }
+}
+
+}  // namespace
+
+void setUp() { fake_cycles = 0; }
+
+void tearDown() {}
+
+void test_counts_updates_steps_and_scheduler_peak() {
+    StepSequencerRuntimeState st;
+    fillPattern(st);
+    StatsTestSink sink;
+    StatsEngine eng(st, sink);
+
+    for (uint32_t tick = 0; tick < 96; ++tick) {
+        eng.update(tick, true);
+    }
+
+    const auto& stats = eng.stats();
+    TEST_ASSERT_EQUAL_UINT32(96, stats.updates);
+    TEST_ASSERT_EQUAL_UINT32(16, stats.stepsAdvanced);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.maxStepsPerUpdate);
+    TEST_ASSERT_TRUE(stats.schedulerPeak >= 4);
+    TEST_ASSERT_TRUE(stats.schedulerPeak <= 8);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.schedulerOverflows);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.sinkFailures);
+    TEST_ASSERT_TRUE(stats.cycleMaskHits > stats.cycleMaskMisses);
+    TEST_ASSERT_TRUE(stats.cycleMaskMisses >= 2);
+
+    // A late host call catches up ten steps in one update.
+    eng.update(95 + 60, true);
+    TEST_ASSERT_EQUAL_UINT32(10, eng.stats().maxStepsPerUpdate);
+}
+
+void test_counts_sink_failures() {
+    StepSequencerRuntimeState st;
+    fillPattern(st);
+    StatsTestSink sink;
+    StatsEngine eng(st, sink);
+
+    eng.update(0, true);
+    sink.accept = false;
+    eng.update(6, true);
+
+    TEST_ASSERT_EQUAL_UINT32(1, eng.stats().sinkFailures);
+}
+
+void test_times_update_with_host_counter_and_resets() {
+    StepSequencerRuntimeState st;
+    fillPattern(st);
+    StatsTestSink sink;
+    StatsEngine eng(st, sink);
+
+    eng.update(0, true);
+    TEST_ASSERT_EQUAL_UINT32(0, eng.stats().maxUpdateCycles);
+
+    eng.setStatsCycleCounter(&fakeCycleCounter);
+    eng.update(1, true);
+    TEST_ASSERT_EQUAL_UINT32(7, eng.stats().lastUpdateCycles);
+    TEST_ASSERT_EQUAL_UINT32(7, eng.stats().maxUpdateCycles);
+
+    eng.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, eng.stats().updates);
+    TEST_ASSERT_EQUAL_UINT32(0, eng.stats().maxUpdateCycles);
+    TEST_ASSERT_EQUAL_UINT32(0, eng.stats().schedulerPeak);
+}
+
+void test_sparse_catch_up_looks_up_masks_per_note() {
+    StepSequencerRuntimeState st;
+    st.length = 128;
+    st.enabledMask.setBit(5);
+    st.enabledMask.setBit(90);
+    StatsTestSink sink;
+    StatsEngine eng(st, sink);
+
+    eng.update(0, true);
+    eng.resetStats();
+    // Ten cycles of 128 steps in one call: two notes per cycle.
+    eng.update(128U * 6U * 10U, true);
+
+    const auto& stats = eng.stats();
+    TEST_ASSERT_EQUAL_UINT32(1280, stats.maxStepsPerUpdate);
+    TEST_ASSERT_EQUAL(40, sink.emitted);
+    TEST_ASSERT_TRUE(stats.cycleMaskHits + stats.cycleMaskMisses < 100);
+}
+
+void test_counts_dropped_parameter_lock_ccs() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.enabledMask.setBit(0);
+    for (uint8_t cc = 1; cc <= 3; ++cc) {
+        st.setParameterLock(0, cc, 64);
+    }
+    StatsTestSink sink;
+    BasicStepSequencerEngine<StatsTestSink, BasicNoteScheduler<4, OverflowPolicy::DropNewest>> eng(st, sink);
+
+    eng.update(0, true);
+
+    // The note pair and two CCs fit; the third CC is dropped.
+    TEST_ASSERT_EQUAL_UINT32(1, eng.stats().schedulerOverflows);
+    TEST_ASSERT_EQUAL_UINT32(4, eng.stats().schedulerPeak);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_counts_updates_steps_and_scheduler_peak);
+    RUN_TEST(test_counts_sink_failures);
+    RUN_TEST(test_times_update_with_host_counter_and_resets);
+    RUN_TEST(test_sparse_catch_up_looks_up_masks_per_note);
+    RUN_TEST(test_counts_dropped_parameter_lock_ccs);
+    return UNITY_END();
+}
@@ -0,0 +1,258 @@
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/midi/OfflineMidiBounce.hpp>
+#include <oc/note/midi/StandardMidiFileWriter.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+using oc::note::midi::MemoryMidiFileOutput;
+using oc::note::midi::MidiBounceOptions;
+using oc::note::midi::StandardMidiFileWriter;
+using oc::note::midi::bounceToMidiFile;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+class NullEventSink final : public ISequencerEventSink {
+public:
+    bool emitSequencerEvent(const SequencerEvent&) override { return true; }
+};
+
+struct ParsedEvent {
+    uint32_t tick;
+    uint8_t status;
+    uint8_t data1;
+    uint8_t data2;
+};
+
+uint32_t readBigEndian32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+           | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+uint32_t readVariableLength(const uint8_t*& cursor) {
+    uint32_t value = 0;
+    uint8_t byte = 0;
+    do {
+        byte = *cursor++;
+        value = (value << 7) | (byte & 0x7Fu);
+    } while ((byte & 0x80u) != 0);
+    return value;
+}
+
+/// Parse one MTrk chunk; meta events are returned with status 0xFF and data1 = meta type.
+std::vector<ParsedEvent> parseTrack(const uint8_t* chunk) {
+    std::vector<ParsedEvent> events;
+    const uint32_t length = readBigEndian32(chunk + 4);
+    const uint8_t* cursor = chunk + 8;
+    const uint8_t* end = cursor + length;
+    uint32_t tick = 0;
+    uint8_t running = 0;
+
+    while (cursor < end) {
+        tick += readVariableLength(cursor);
+        if (*cursor == 0xFF) {
+            const uint8_t type = cursor[1];
+            cursor += 2;
+            const uint32_t metaLength = readVariableLength(cursor);
+            events.push_back({tick, 0xFF, type, 0});
+            cursor += metaLength;
+            continue;
+        }
+        if ((*cursor & 0x80u) != 0) running = *cursor++;
+        events.push_back({tick, running, cursor[0], cursor[1]});
+        cursor += 2;
+    }
+    return events;
+}
+
+void fillPattern(StepSequencerRuntimeState& st) {
+    st.length = 8;
+    st.stepsPerBeat = 4;
+    st.midiChannel = 2;
+    st.enabledMask = StepBitMask128::fromLower64(0b10110101);
+    for (uint8_t i = 0; i < 8; ++i) {
+        st.note[i] = static_cast<uint8_t>(60 + i);
+        st.velocity[i] = static_cast<uint8_t>(90 + i);
+        st.gate[i] = 150;
+        st.probability[i] = static_cast<uint8_t>((i % 2 == 0) ? 100 : 50);
+    }
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_variable_length_encoding() {
+    uint8_t out[4];
+
+    TEST_ASSERT_EQUAL(1, static_cast<int>(StandardMidiFileWriter::encodeVariableLength(0, out)));
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[0]);
+
+    TEST_ASSERT_EQUAL(1, static_cast<int>(StandardMidiFileWriter::encodeVariableLength(0x7F, out)));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, out[0]);
+
+    TEST_ASSERT_EQUAL(2, static_cast<int>(StandardMidiFileWriter::encodeVariableLength(0x80, out)));
+    TEST_ASSERT_EQUAL_HEX8(0x81, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[1]);
+
+    TEST_ASSERT_EQUAL(3, static_cast<int>(StandardMidiFileWriter::encodeVariableLength(0x4000, out)));
+    TEST_ASSERT_EQUAL_HEX8(0x81, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x80, out[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[2]);
+
+    TEST_ASSERT_EQUAL(4, static_cast<int>(StandardMidiFileWriter::encodeVariableLength(0x0FFFFFFF, out)));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x7F, out[3]);
+}
+
+void test_bounce_writes_type0_file_matching_engine_output() {
+    StepSequencerRuntimeState pattern;
+    fillPattern(pattern);
+
+    std::vector<uint8_t> file(8192);
+    MemoryMidiFileOutput output(file.data(), file.size());
+    std::array<uint8_t, 32> staging{};
+
+    MidiBounceOptions options;
+    options.bars = 4;
+    options.bpm = 125.0f;
+    options.runSeed = 7;
+    const auto result = bounceToMidiFile(pattern, options, output, staging.data(), staging.size());
+
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_EQUAL(static_cast<int>(output.size()), static_cast<int>(result.bytesWritten));
+    TEST_ASSERT_EQUAL_MEMORY("MThd", file.data(), 4);
+    TEST_ASSERT_EQUAL_UINT32(6, readBigEndian32(file.data() + 4));
+    TEST_ASSERT_EQUAL_UINT8(0, file[9]);    // format 0
+    TEST_ASSERT_EQUAL_UINT8(1, file[11]);   // one track
+    TEST_ASSERT_EQUAL_UINT8(24, file[13]);  // PPQN
+    TEST_ASSERT_EQUAL_MEMORY("MTrk", file.data() + 14, 4);
+    TEST_ASSERT_EQUAL_UINT32(output.size() - 22U, readBigEndian32(file.data() + 18));
+
+    const std::vector<ParsedEvent> parsed = parseTrack(file.data() + 14);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, parsed.front().status);
+    TEST_ASSERT_EQUAL_UINT8(0x51, parsed.front().data1);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, parsed.back().status);
+    TEST_ASSERT_EQUAL_UINT8(0x2F, parsed.back().data1);
+
+    // Same seed, same pattern, rendered live: the file must hold exactly those notes.
+    StepSequencerRuntimeState liveState;
+    fillPattern(liveState);
+    NullEventSink sink;
+    StepSequencerEngine live(liveState, sink);
+    live.setNextRunSeed(options.runSeed);
+    std::array<SequencerEvent, 512> expected{};
+    const auto rendered = live.renderRange(0, 4U * 96U, expected.data(), expected.size());
+    TEST_ASSERT_TRUE(rendered.complete);
+
+    int noteOns = 0;
+    int noteOffs = 0;
+    size_t cursor = 0;
+    for (size_t i = 1; i + 1 < parsed.size(); ++i) {
+        const ParsedEvent& e = parsed[i];
+        TEST_ASSERT_EQUAL_UINT8(2, e.status & 0x0Fu);
+        if ((e.status & 0xF0u) == 0x90) ++noteOns;
+        if ((e.status & 0xF0u) == 0x80) ++noteOffs;
+        if (cursor < rendered.eventCount) {
+            TEST_ASSERT_EQUAL_UINT32(expected[cursor].tick, e.tick);
+            TEST_ASSERT_EQUAL_UINT8(expected[cursor].note, e.data1);
+            ++cursor;
+        }
+    }
+    TEST_ASSERT_EQUAL(static_cast<int>(rendered.eventCount), static_cast<int>(cursor));
+    TEST_ASSERT_TRUE(noteOns > 0);
+    TEST_ASSERT_EQUAL(noteOns, noteOffs);
+}
+
+void test_bounce_type1_has_tempo_track() {
+    StepSequencerRuntimeState pattern;
+    fillPattern(pattern);
+
+    std::vector<uint8_t> file(8192);
+    MemoryMidiFileOutput output(file.data(), file.size());
+    std::array<uint8_t, 64> staging{};
+
+    MidiBounceOptions options;
+    options.bars = 2;
+    options.format = 1;
+    const auto result = bounceToMidiFile(pattern, options, output, staging.data(), staging.size());
+    TEST_ASSERT_TRUE(result.ok);
+    TEST_ASSERT_EQUAL_UINT8(1, file[9]);
+    TEST_ASSERT_EQUAL_UINT8(2, file[11]);
+
+    const uint32_t tempoLength = readBigEndian32(file.data() + 18);
+    const std::vector<ParsedEvent> tempo = parseTrack(file.data() + 14);
+    TEST_ASSERT_EQUAL(2, static_cast<int>(tempo.size()));
+    TEST_ASSERT_EQUAL_UINT8(0x51, tempo[0].data1);
+
+    const uint8_t* notes = file.data() + 22 + tempoLength;
+    TEST_ASSERT_EQUAL_MEMORY("MTrk", notes, 4);
+    TEST_ASSERT_EQUAL(static_cast<int>(output.size()),
+                      static_cast<int>(22 + tempoLength + 8 + readBigEndian32(notes + 4)));
+    TEST_ASSERT_EQUAL(static_cast<int>(result.eventCount), static_cast<int>(parseTrack(notes).size() - 1));
+}
+
+void test_bounce_reports_output_overflow() {
+    StepSequencerRuntimeState pattern;
+    fillPattern(pattern);
+
+    std::array<uint8_t, 64> file{};
+    MemoryMidiFileOutput output(file.data(), file.size());
+    std::array<uint8_t, 16> staging{};
+
+    MidiBounceOptions options;
+    options.bars = 8;
+    TEST_ASSERT_FALSE(bounceToMidiFile(pattern, options, output, staging.data(), staging.size()).ok);
+}
+
+void test_tempo_is_clamped_to_the_24_bit_field() {
+    std::array<uint8_t, 64> file{};
+    MemoryMidiFileOutput output(file.data(), file.size());
+    std::array<uint8_t, 16> staging{};
+    StandardMidiFileWriter writer(output, staging.data(), staging.size());
+    TEST_ASSERT_TRUE(writer.beginTrack());
+    TEST_ASSERT_TRUE(writer.writeTempo(0, 0x01000000u));
+    TEST_ASSERT_TRUE(writer.writeTempo(0, 0));
+    TEST_ASSERT_TRUE(writer.flush());
+
+    const uint8_t expected[] = {
+        0x00, 0xFF, 0x51, 0x03, 0xFF, 0xFF, 0xFF,
+        0x00, 0xFF, 0x51, 0x03, 0x00, 0x00, 0x01,
+    };
+    TEST_ASSERT_EQUAL_MEMORY(expected, file.data() + 8, sizeof(expected));
+
+    // 2 bpm is 30 s per quarter, past what the field holds.
+    StepSequencerRuntimeState pattern;
+    fillPattern(pattern);
+    std::vector<uint8_t> bounced(8192);
+    MemoryMidiFileOutput bounceOutput(bounced.data(), bounced.size());
+    MidiBounceOptions options;
+    options.bpm = 2.0f;
+    TEST_ASSERT_TRUE(bounceToMidiFile(pattern, options, bounceOutput, staging.data(), staging.size()).ok);
+    TEST_ASSERT_EQUAL_HEX8(0x51, bounced[24]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, bounced[26]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, bounced[27]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, bounced[28]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_variable_length_encoding);
+    RUN_TEST(test_bounce_writes_type0_file_matching_engine_output);
+    RUN_TEST(test_bounce_type1_has_tempo_track);
+    RUN_TEST(test_bounce_reports_output_overflow);
+    RUN_TEST(test_tempo_is_clamped_to_the_24_bit_field);
+    return UNITY_END();
+}
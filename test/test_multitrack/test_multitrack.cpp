@@ -0,0 +1,243 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/sequencer/MultiTrackSequencerEngine.hpp>
+#include <oc/note/sequencer/MultiTrackSequencerState.hpp>
+#include <oc/note/sequencer/SequencerConfig.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+using oc::note::sequencer::DrumLaneSequencerConfig;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::MultiTrackSequencerEngine;
+using oc::note::sequencer::MultiTrackSequencerState;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+class MockEventSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        events.push_back(event);
+        return true;
+    }
+};
+
+bool sameEvent(const SequencerEvent& lhs, const SequencerEvent& rhs) {
+    return lhs.tick == rhs.tick && lhs.type == rhs.type && lhs.channel == rhs.channel
+           && lhs.note == rhs.note && lhs.velocity == rhs.velocity;
+}
+
+bool eventLess(const SequencerEvent& lhs, const SequencerEvent& rhs) {
+    if (lhs.tick != rhs.tick) return lhs.tick < rhs.tick;
+    if (lhs.type != rhs.type) return lhs.type < rhs.type;
+    if (lhs.channel != rhs.channel) return lhs.channel < rhs.channel;
+    return lhs.note < rhs.note;
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_tracks_share_one_sink_in_time_order() {
+    MultiTrackSequencerState<2> st;
+    st.length[0] = 2;
+    st.length[1] = 3;
+    st.midiChannel[1] = 1;
+    st.enabledMask[0] = StepBitMask128::fromLower64(0b01);
+    st.enabledMask[1] = StepBitMask128::fromLower64(0b010);
+    st.note[st.stepSlot(0, 0)] = 60;
+    st.note[st.stepSlot(1, 1)] = 67;
+    st.gate[st.stepSlot(0, 0)] = 50;
+    st.gate[st.stepSlot(1, 1)] = 50;
+
+    MockEventSink sink;
+    MultiTrackSequencerEngine<2> eng(st, sink);
+
+    for (uint32_t tick = 0; tick <= 12; ++tick) {
+        eng.update(tick, true);
+    }
+
+    TEST_ASSERT_EQUAL(5, static_cast<int>(sink.events.size()));
+    for (size_t i = 1; i < sink.events.size(); ++i) {
+        TEST_ASSERT_TRUE(sink.events[i - 1].tick <= sink.events[i].tick);
+    }
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[0].note);
+    TEST_ASSERT_EQUAL_UINT8(67, sink.events[2].note);
+    TEST_ASSERT_EQUAL_UINT8(1, sink.events[2].channel);
+    TEST_ASSERT_EQUAL_UINT32(6, sink.events[2].tick);
+    TEST_ASSERT_EQUAL(0, st.playheadStep[0]);
+    TEST_ASSERT_EQUAL(2, st.playheadStep[1]);
+}
+
+void test_matches_independent_engines_for_deterministic_patterns() {
+    constexpr uint8_t TRACKS = 16;
+    MultiTrackSequencerState<TRACKS> multi;
+    std::array<StepSequencerRuntimeState, TRACKS> singles;
+
+    for (uint8_t t = 0; t < TRACKS; ++t) {
+        const uint8_t len = static_cast<uint8_t>(4 + t);
+        const uint64_t enabled = 0x5A5A5A5AULL >> (t % 4);
+        const uint8_t spb = static_cast<uint8_t>((t % 3 == 0) ? 4 : 2);
+
+        multi.length[t] = len;
+        multi.stepsPerBeat[t] = spb;
+        multi.midiChannel[t] = t;
+        multi.enabledMask[t] = StepBitMask128::fromLower64(enabled);
+        singles[t].length = len;
+        singles[t].stepsPerBeat = spb;
+        singles[t].midiChannel = t;
+        singles[t].enabledMask = StepBitMask128::fromLower64(enabled);
+
+        for (uint8_t s = 0; s < len; ++s) {
+            const uint8_t note = static_cast<uint8_t>(36 + t + s);
+            const uint16_t gate = static_cast<uint16_t>(25 + (s * 17) % 175);
+            const int8_t nudge = static_cast<int8_t>((s % 5) * 20 - 40);
+            multi.note[multi.stepSlot(t, s)] = note;
+            multi.gate[multi.stepSlot(t, s)] = gate;
+            multi.nudge[multi.stepSlot(t, s)] = nudge;
+            singles[t].note[s] = note;
+            singles[t].gate[s] = gate;
+            singles[t].nudge[s] = nudge;
+        }
+    }
+
+    MockEventSink multiSink;
+    MultiTrackSequencerEngine<TRACKS> multiEngine(multi, multiSink);
+    MockEventSink singleSink;
+    std::vector<StepSequencerEngine> singleEngines;
+    singleEngines.reserve(TRACKS);
+    for (uint8_t t = 0; t < TRACKS; ++t) {
+        singleEngines.emplace_back(singles[t], singleSink);
+    }
+
+    for (uint32_t tick = 0; tick < 400; ++tick) {
+        multiEngine.update(tick, true);
+        for (auto& engine : singleEngines) {
+            engine.update(tick, true);
+        }
+    }
+
+    std::sort(multiSink.events.begin(), multiSink.events.end(), eventLess);
+    std::sort(singleSink.events.begin(), singleSink.events.end(), eventLess);
+    TEST_ASSERT_EQUAL(static_cast<int>(singleSink.events.size()), static_cast<int>(multiSink.events.size()));
+    for (size_t i = 0; i < multiSink.events.size(); ++i) {
+        TEST_ASSERT_TRUE(sameEvent(singleSink.events[i], multiSink.events[i]));
+    }
+    for (uint8_t t = 0; t < TRACKS; ++t) {
+        TEST_ASSERT_EQUAL(singles[t].playheadStep, multi.playheadStep[t]);
+    }
+}
+
+void test_stop_sends_single_all_notes_off() {
+    MultiTrackSequencerState<4> st;
+    for (uint8_t t = 0; t < 4; ++t) {
+        st.enabledMask[t] = StepBitMask128::fromLower64(0xFF);
+    }
+
+    MockEventSink sink;
+    MultiTrackSequencerEngine<4> eng(st, sink);
+
+    eng.update(0, true);
+    eng.update(7, true);
+    const size_t before = sink.events.size();
+
+    eng.update(8, false);
+    TEST_ASSERT_EQUAL(static_cast<int>(before + 1), static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(SequencerEventType::AllNotesOff),
+                      static_cast<uint8_t>(sink.events.back().type));
+    TEST_ASSERT_EQUAL(-1, st.playheadStep[3]);
+    TEST_ASSERT_EQUAL(0, static_cast<int>(eng.pendingEventCount()));
+}
+
+void test_gate_is_clamped_to_max_percent() {
+    MultiTrackSequencerState<2> st;
+    for (uint8_t t = 0; t < 2; ++t) {
+        st.length[t] = 1;
+        st.stepsPerBeat[t] = 1;
+        st.enabledMask[t] = StepBitMask128::fromLower64(0b1);
+        st.note[st.stepSlot(t, 0)] = static_cast<uint8_t>(60 + t);
+        st.gate[st.stepSlot(t, 0)] = 50;
+    }
+    // 10000% of a 960-tick step would not fit the scheduler's tick span.
+    st.gate[st.stepSlot(0, 0)] = 10000;
+
+    MockEventSink sink;
+    MultiTrackSequencerEngine<2> eng(st, sink);
+    eng.setTicksPerQuarter(960);
+    for (uint32_t tick = 0; tick <= 2000; ++tick) {
+        eng.update(tick, true);
+    }
+
+    bool releasedAtMaxGate = false;
+    for (const auto& e : sink.events) {
+        TEST_ASSERT_TRUE(e.type != SequencerEventType::AllNotesOff);
+        if (e.type == SequencerEventType::NoteOff && e.note == 60 && e.tick == 1920) releasedAtMaxGate = true;
+    }
+    TEST_ASSERT_TRUE(releasedAtMaxGate);
+}
+
+void test_drum_lane_config_matches_default_config() {
+    constexpr uint8_t TRACKS = 8;
+    using Lanes = MultiTrackSequencerState<TRACKS, DrumLaneSequencerConfig>;
+    using Wide = MultiTrackSequencerState<TRACKS>;
+    Lanes lanes;
+    Wide wide;
+
+    for (uint8_t t = 0; t < TRACKS; ++t) {
+        const uint64_t enabled = 0x9249u >> t;
+        lanes.length[t] = 16;
+        wide.length[t] = 16;
+        lanes.midiChannel[t] = 9;
+        wide.midiChannel[t] = 9;
+        lanes.enabledMask[t] = Lanes::StepMask::fromLower64(enabled);
+        wide.enabledMask[t] = StepBitMask128::fromLower64(enabled);
+        for (uint8_t s = 0; s < 16; ++s) {
+            const uint8_t note = static_cast<uint8_t>(36 + t);
+            const uint8_t probability = static_cast<uint8_t>((s % 3 == 0) ? 100 : 60);
+            lanes.note[lanes.stepSlot(t, s)] = note;
+            wide.note[wide.stepSlot(t, s)] = note;
+            lanes.probability[lanes.stepSlot(t, s)] = probability;
+            wide.probability[wide.stepSlot(t, s)] = probability;
+        }
+    }
+
+    MockEventSink laneSink;
+    MultiTrackSequencerEngine<TRACKS, DrumLaneSequencerConfig> laneEngine(lanes, laneSink);
+    MockEventSink wideSink;
+    MultiTrackSequencerEngine<TRACKS> wideEngine(wide, wideSink);
+    for (uint32_t tick = 0; tick < 600; ++tick) {
+        laneEngine.update(tick, true);
+        wideEngine.update(tick, true);
+    }
+
+    TEST_ASSERT_TRUE(laneSink.events.size() > 50);
+    TEST_ASSERT_EQUAL(static_cast<int>(wideSink.events.size()), static_cast<int>(laneSink.events.size()));
+    for (size_t i = 0; i < laneSink.events.size(); ++i) {
+        TEST_ASSERT_TRUE(sameEvent(wideSink.events[i], laneSink.events[i]));
+    }
+    TEST_ASSERT_TRUE(sizeof(Lanes) * 6 < sizeof(Wide));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tracks_share_one_sink_in_time_order);
+    RUN_TEST(test_matches_independent_engines_for_deterministic_patterns);
+    RUN_TEST(test_stop_sends_single_all_notes_off);
+    RUN_TEST(test_gate_is_clamped_to_max_percent);
+    RUN_TEST(test_drum_lane_config_matches_default_config);
+    return UNITY_END();
+}
@@ -0,0 +1,150 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/sequencer/MultiTrackSequencerEngine.hpp>
+#include <oc/note/sequencer/MultiTrackSequencerState.hpp>
+#include <oc/note/sequencer/PackedMultiTrackSequencerState.hpp>
+#include <oc/note/sequencer/PackedStep.hpp>
+#include <oc/note/sequencer/SequencerConfig.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+using oc::note::sequencer::DrumLaneSequencerConfig;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::MultiTrackSequencerEngine;
+using oc::note::sequencer::MultiTrackSequencerState;
+using oc::note::sequencer::PackedMultiTrackSequencerEngine;
+using oc::note::sequencer::PackedMultiTrackSequencerState;
+using oc::note::sequencer::PackedStep;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepFields;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+class MockEventSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        events.push_back(event);
+        return true;
+    }
+};
+
+bool sameEvent(const SequencerEvent& lhs, const SequencerEvent& rhs) {
+    return lhs.tick == rhs.tick && lhs.type == rhs.type && lhs.channel == rhs.channel
+           && lhs.note == rhs.note && lhs.velocity == rhs.velocity;
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_packed_step_round_trips_and_clamps() {
+    for (uint16_t gate = 0; gate <= StepSequencerRuntimeState::MAX_GATE_PERCENT; ++gate) {
+        for (int nudge = -50; nudge <= 50; nudge += 5) {
+            const StepFields in{static_cast<uint8_t>(gate % 128U), static_cast<uint8_t>(127U - gate % 128U),
+                                gate, static_cast<int8_t>(nudge)};
+            const StepFields out = PackedStep::unpack(PackedStep::pack(in));
+            TEST_ASSERT_EQUAL_UINT8(in.note, out.note);
+            TEST_ASSERT_EQUAL_UINT8(in.velocity, out.velocity);
+            TEST_ASSERT_EQUAL_UINT16(in.gate, out.gate);
+            TEST_ASSERT_EQUAL_INT8(in.nudge, out.nudge);
+        }
+    }
+
+    const StepFields clamped = PackedStep::unpack(PackedStep::pack({200, 255, 999, -128}));
+    TEST_ASSERT_EQUAL_UINT8(127, clamped.note);
+    TEST_ASSERT_EQUAL_UINT8(127, clamped.velocity);
+    TEST_ASSERT_EQUAL_UINT16(200, clamped.gate);
+    TEST_ASSERT_EQUAL_INT8(-50, clamped.nudge);
+}
+
+void test_runtime_state_track_round_trips() {
+    StepSequencerRuntimeState source;
+    source.length = 13;
+    source.stepsPerBeat = 2;
+    source.midiChannel = 9;
+    source.enabledMask = StepBitMask128::fromLower64(0x1ACDu);
+    for (uint8_t i = 0; i < 16; ++i) {
+        source.note[i] = static_cast<uint8_t>(36 + i);
+        source.velocity[i] = static_cast<uint8_t>(i * 8);
+        source.gate[i] = static_cast<uint16_t>(i * 13);
+        source.nudge[i] = static_cast<int8_t>(i * 6 - 45);
+        source.probability[i] = static_cast<uint8_t>(i * 6);
+    }
+
+    PackedMultiTrackSequencerState<4, DrumLaneSequencerConfig> packed;
+    packed.packTrack(2, source);
+
+    StepSequencerRuntimeState target;
+    packed.unpackTrack(2, target);
+    TEST_ASSERT_EQUAL_UINT8(13, target.length);
+    TEST_ASSERT_EQUAL_UINT8(2, target.stepsPerBeat);
+    TEST_ASSERT_EQUAL_UINT8(9, target.midiChannel);
+    TEST_ASSERT_TRUE(target.enabledMask == source.enabledMask);
+    for (uint8_t i = 0; i < 16; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(source.note[i], target.note[i]);
+        TEST_ASSERT_EQUAL_UINT8(source.velocity[i], target.velocity[i]);
+        TEST_ASSERT_EQUAL_UINT16(source.gate[i], target.gate[i]);
+        TEST_ASSERT_EQUAL_INT8(source.nudge[i], target.nudge[i]);
+        TEST_ASSERT_EQUAL_UINT8(source.probability[i], target.probability[i]);
+    }
+}
+
+void test_packed_state_plays_like_unpacked_state() {
+    constexpr uint8_t TRACKS = 8;
+    using Config = DrumLaneSequencerConfig;
+    MultiTrackSequencerState<TRACKS, Config> unpacked;
+    for (uint8_t t = 0; t < TRACKS; ++t) {
+        unpacked.length[t] = static_cast<uint8_t>(10 + t);
+        unpacked.stepsPerBeat[t] = static_cast<uint8_t>((t % 2 == 0) ? 4 : 3);
+        unpacked.midiChannel[t] = t;
+        unpacked.enabledMask[t] = decltype(unpacked)::StepMask::fromLower64(0xB6DBu >> (t % 3));
+        for (uint8_t s = 0; s < 16; ++s) {
+            const size_t slot = unpacked.stepSlot(t, s);
+            unpacked.note[slot] = static_cast<uint8_t>(36 + t * 2 + s % 3);
+            unpacked.velocity[slot] = static_cast<uint8_t>(40 + s * 5);
+            unpacked.gate[slot] = static_cast<uint16_t>((s % 5 == 4) ? 0 : 20 + s * 11);
+            unpacked.nudge[slot] = static_cast<int8_t>((s % 4) * 25 - 40);
+            unpacked.probability[slot] = static_cast<uint8_t>((s % 3 == 0) ? 100 : 35 + s * 4);
+        }
+    }
+
+    PackedMultiTrackSequencerState<TRACKS, Config> packed;
+    packed.packFrom(unpacked);
+
+    MockEventSink unpackedSink;
+    MultiTrackSequencerEngine<TRACKS, Config> unpackedEngine(unpacked, unpackedSink);
+    MockEventSink packedSink;
+    PackedMultiTrackSequencerEngine<TRACKS, Config> packedEngine(packed, packedSink);
+    for (uint32_t tick = 0; tick < 800; ++tick) {
+        unpackedEngine.update(tick, true);
+        packedEngine.update(tick, true);
+    }
+
+    TEST_ASSERT_TRUE(packedSink.events.size() > 100);
+    TEST_ASSERT_EQUAL(static_cast<int>(unpackedSink.events.size()),
+                      static_cast<int>(packedSink.events.size()));
+    for (size_t i = 0; i < packedSink.events.size(); ++i) {
+        TEST_ASSERT_TRUE(sameEvent(unpackedSink.events[i], packedSink.events[i]));
+    }
+    for (uint8_t t = 0; t < TRACKS; ++t) {
+        TEST_ASSERT_EQUAL(unpacked.playheadStep[t], packed.playheadStep[t]);
+    }
+    TEST_ASSERT_TRUE(sizeof(packed) < sizeof(unpacked));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_packed_step_round_trips_and_clamps);
+    RUN_TEST(test_runtime_state_track_round_trips);
+    RUN_TEST(test_packed_state_plays_like_unpacked_state);
+    return UNITY_END();
+}
@@ -0,0 +1,223 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepParameterLocks.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+
+using oc::note::sequencer::BasicNoteScheduler;
+using oc::note::sequencer::BasicStepSequencerEngine;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::OverflowPolicy;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepParameterLocks;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerRuntimeState;
+
+namespace {
+
+class MockEventSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        events.push_back(event);
+        return true;
+    }
+};
+
+constexpr uint8_t CUTOFF = 74;
+constexpr uint8_t RESONANCE = 71;
+
+int countType(const std::vector<SequencerEvent>& events, SequencerEventType type) {
+    int count = 0;
+    for (const auto& e : events) {
+        if (e.type == type) ++count;
+    }
+    return count;
+}
+
+/// One step with three locks, played through a four-slot scheduler: the third CC does not fit.
+template <OverflowPolicy Policy>
+std::vector<SequencerEvent> playLockedStepWithFourSlots() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask.setBit(0);
+    st.note[0] = 60;
+    st.setParameterLock(0, CUTOFF, 100);
+    st.setParameterLock(0, RESONANCE, 20);
+    st.setParameterLock(0, 1, 64);
+
+    MockEventSink sink;
+    BasicStepSequencerEngine<ISequencerEventSink, BasicNoteScheduler<4, Policy>> eng(st, sink);
+    for (uint32_t tick = 0; tick < 6; ++tick) {
+        eng.update(tick, true);
+    }
+    return sink.events;
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_locks_are_packed_by_rank_across_lanes() {
+    StepParameterLocks locks;
+    TEST_ASSERT_TRUE(locks.set(9, CUTOFF, 90));
+    TEST_ASSERT_TRUE(locks.set(100, RESONANCE, 10));
+    TEST_ASSERT_TRUE(locks.set(3, CUTOFF, 30));
+    TEST_ASSERT_TRUE(locks.set(70, CUTOFF, 70));
+    TEST_ASSERT_EQUAL_UINT16(4, locks.used);
+
+    const uint8_t cutoff = locks.laneOf(CUTOFF);
+    const uint8_t resonance = locks.laneOf(RESONANCE);
+    TEST_ASSERT_EQUAL_UINT8(30, locks.value(cutoff, 3));
+    TEST_ASSERT_EQUAL_UINT8(90, locks.value(cutoff, 9));
+    TEST_ASSERT_EQUAL_UINT8(70, locks.value(cutoff, 70));
+    TEST_ASSERT_EQUAL_UINT8(10, locks.value(resonance, 100));
+    TEST_ASSERT_FALSE(locks.isLocked(cutoff, 4));
+
+    TEST_ASSERT_TRUE(locks.remove(9, CUTOFF));
+    TEST_ASSERT_FALSE(locks.remove(9, CUTOFF));
+    TEST_ASSERT_EQUAL_UINT8(70, locks.value(cutoff, 70));
+    TEST_ASSERT_EQUAL_UINT8(10, locks.value(resonance, 100));
+
+    TEST_ASSERT_TRUE(locks.remove(100, RESONANCE));
+    TEST_ASSERT_EQUAL_UINT8(StepParameterLocks::MAX_LANES, locks.laneOf(RESONANCE));
+    TEST_ASSERT_EQUAL_UINT8(1U << cutoff, locks.activeLanes);
+
+    for (uint8_t cc = 0; cc < StepParameterLocks::MAX_LANES - 1U; ++cc) {
+        TEST_ASSERT_TRUE(locks.set(0, cc, 1));
+    }
+    TEST_ASSERT_FALSE(locks.set(0, RESONANCE, 1));
+
+    // Storage is sized by lock count, not steps x controllers.
+    TEST_ASSERT_TRUE(sizeof(StepParameterLocks) < StepSequencerRuntimeState::MAX_STEPS * 4U);
+}
+
+void test_engine_sends_locks_before_note_on_and_restores_after() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.midiChannel = 2;
+    st.enabledMask = StepBitMask128::prefixMask(4);
+    st.setParameterLock(1, CUTOFF, 100);
+    st.parameterLocks.setRestore(CUTOFF, 64);
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    for (uint32_t tick = 0; tick < 24; ++tick) {
+        eng.update(tick, true);
+    }
+
+    std::vector<SequencerEvent> ccs;
+    for (size_t i = 0; i < sink.events.size(); ++i) {
+        const SequencerEvent& e = sink.events[i];
+        if (e.type != SequencerEventType::ControlChange) continue;
+        ccs.push_back(e);
+        TEST_ASSERT_TRUE(i + 1U < sink.events.size());
+        TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::NoteOn),
+                          static_cast<int>(sink.events[i + 1U].type));
+        TEST_ASSERT_EQUAL_UINT32(e.tick, sink.events[i + 1U].tick);
+    }
+
+    TEST_ASSERT_EQUAL(2, static_cast<int>(ccs.size()));
+    TEST_ASSERT_EQUAL_UINT32(6, ccs[0].tick);
+    TEST_ASSERT_EQUAL_UINT8(2, ccs[0].channel);
+    TEST_ASSERT_EQUAL_UINT8(CUTOFF, ccs[0].note);
+    TEST_ASSERT_EQUAL_UINT8(100, ccs[0].velocity);
+    TEST_ASSERT_EQUAL_UINT32(12, ccs[1].tick);
+    TEST_ASSERT_EQUAL_UINT8(64, ccs[1].velocity);
+}
+
+void test_restore_follows_the_last_step_that_played() {
+    for (int variant = 0; variant < 2; ++variant) {
+        StepSequencerRuntimeState st;
+        st.length = 4;
+        st.stepsPerBeat = 4;
+        st.enabledMask = StepBitMask128::prefixMask(4);
+        st.setParameterLock(0, CUTOFF, 100);
+        st.parameterLocks.setRestore(CUTOFF, 10);
+        // Step 1 never plays: disabled, or enabled with probability 0.
+        if (variant == 0) {
+            st.setStepEnabled(1, false);
+        } else {
+            st.setProbability(1, 0);
+        }
+
+        MockEventSink sink;
+        StepSequencerEngine eng(st, sink);
+        for (uint32_t tick = 0; tick <= 24; ++tick) {
+            eng.update(tick, true);
+        }
+
+        std::vector<SequencerEvent> ccs;
+        for (const auto& e : sink.events) {
+            if (e.type == SequencerEventType::ControlChange) ccs.push_back(e);
+        }
+        TEST_ASSERT_EQUAL(3, static_cast<int>(ccs.size()));
+        TEST_ASSERT_EQUAL_UINT32(0, ccs[0].tick);
+        TEST_ASSERT_EQUAL_UINT8(100, ccs[0].velocity);
+        TEST_ASSERT_EQUAL_UINT32(12, ccs[1].tick);
+        TEST_ASSERT_EQUAL_UINT8(10, ccs[1].velocity);
+        TEST_ASSERT_EQUAL_UINT32(24, ccs[2].tick);
+        TEST_ASSERT_EQUAL_UINT8(100, ccs[2].velocity);
+    }
+}
+
+void test_live_lock_edit_replaces_queued_cc() {
+    StepSequencerRuntimeState st;
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(4);
+    st.setParameterLock(2, CUTOFF, 20);
+
+    MockEventSink sink;
+    StepSequencerEngine eng(st, sink);
+    for (uint32_t tick = 0; tick <= 7; ++tick) {
+        eng.update(tick, true);
+    }
+
+    // Step 2 (tick 12) is queued with its old lock.
+    TEST_ASSERT_TRUE(st.setParameterLock(2, CUTOFF, 99));
+    for (uint32_t tick = 8; tick <= 12; ++tick) {
+        eng.update(tick, true);
+    }
+
+    int ccCount = 0;
+    for (const auto& e : sink.events) {
+        if (e.type != SequencerEventType::ControlChange) continue;
+        ++ccCount;
+        TEST_ASSERT_EQUAL_UINT8(99, e.velocity);
+    }
+    TEST_ASSERT_EQUAL(1, ccCount);
+}
+
+void test_cc_overflow_follows_scheduler_policy() {
+    const auto cleared = playLockedStepWithFourSlots<OverflowPolicy::ClearAll>();
+    TEST_ASSERT_EQUAL(1, countType(cleared, SequencerEventType::AllNotesOff));
+    TEST_ASSERT_EQUAL(0, countType(cleared, SequencerEventType::NoteOn));
+    TEST_ASSERT_EQUAL(0, countType(cleared, SequencerEventType::ControlChange));
+
+    const auto dropped = playLockedStepWithFourSlots<OverflowPolicy::DropNewest>();
+    TEST_ASSERT_EQUAL(0, countType(dropped, SequencerEventType::AllNotesOff));
+    TEST_ASSERT_EQUAL(1, countType(dropped, SequencerEventType::NoteOn));
+    TEST_ASSERT_EQUAL(2, countType(dropped, SequencerEventType::ControlChange));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_locks_are_packed_by_rank_across_lanes);
+    RUN_TEST(test_engine_sends_locks_before_note_on_and_restores_after);
+    RUN_TEST(test_restore_follows_the_last_step_that_played);
+    RUN_TEST(test_live_lock_edit_replaces_queued_cc);
+    RUN_TEST(test_cc_overflow_follows_scheduler_policy);
+    return UNITY_END();
+}
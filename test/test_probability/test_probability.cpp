@@ -0,0 +1,111 @@
+#include <unity.h>
+
+#include <array>
+#include <cstdint>
+
+#include <oc/note/sequencer/ProbabilityMaskKernel.hpp>
+#include <oc/note/sequencer/StepBitMask128.hpp>
+#include <oc/note/sequencer/StepSequencerMath.hpp>
+
+using oc::note::sequencer::ProbabilityMaskInput;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::probabilityHash;
+using oc::note::sequencer::resolveProbabilityMask;
+using oc::note::sequencer::resolveProbabilityMaskScalar;
+
+namespace {
+
+constexpr uint8_t STEPS = 128;
+
+uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/// The per-step loop the engine used before the kernel existed.
+StepBitMask128 referenceMask(const ProbabilityMaskInput& input) {
+    StepBitMask128 mask{};
+    for (uint8_t i = 0; i < input.length; ++i) {
+        if (!input.enabledMask.test(i)) continue;
+        if (input.gate[i] == 0) continue;
+        const uint8_t probability = (input.probability[i] > 100U) ? 100U : input.probability[i];
+        if (probability >= 100U) {
+            mask.setBit(i, true);
+            continue;
+        }
+        if (probability == 0U) continue;
+        if ((probabilityHash(input.runSeed, input.cycleIndex, i) % 100U) < probability) {
+            mask.setBit(i, true);
+        }
+    }
+    return mask;
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_kernel_matches_reference_for_random_patterns() {
+    std::array<uint8_t, STEPS> probability{};
+    std::array<uint16_t, STEPS> gate{};
+    uint32_t rng = 0xC0FFEEu;
+
+    for (int round = 0; round < 2000; ++round) {
+        for (uint8_t i = 0; i < STEPS; ++i) {
+            const uint32_t r = nextRandom(rng);
+            // Bias towards the 0 / 100 / >100 edge cases.
+            switch (r % 5U) {
+                case 0: probability[i] = 0; break;
+                case 1: probability[i] = 100; break;
+                case 2: probability[i] = static_cast<uint8_t>(101U + (r >> 8) % 155U); break;
+                default: probability[i] = static_cast<uint8_t>((r >> 8) % 100U); break;
+            }
+            gate[i] = static_cast<uint16_t>(((r >> 20) % 4U == 0) ? 0U : (r >> 12) % 201U);
+        }
+
+        ProbabilityMaskInput input{};
+        input.probability = probability.data();
+        input.gate = gate.data();
+        input.enabledMask = {.low = (uint64_t{nextRandom(rng)} << 32) | nextRandom(rng),
+                             .high = (uint64_t{nextRandom(rng)} << 32) | nextRandom(rng)};
+        input.length = static_cast<uint8_t>(nextRandom(rng) % (STEPS + 1U));
+        input.runSeed = nextRandom(rng);
+        input.cycleIndex = nextRandom(rng);
+
+        const StepBitMask128 expected = referenceMask(input);
+        TEST_ASSERT_TRUE(expected == resolveProbabilityMask(input));
+        TEST_ASSERT_TRUE(expected == resolveProbabilityMaskScalar(input));
+    }
+}
+
+void test_kernel_handles_all_or_nothing_blocks() {
+    std::array<uint8_t, STEPS> probability{};
+    std::array<uint16_t, STEPS> gate{};
+    probability.fill(100);
+    gate.fill(100);
+    probability[3] = 0;
+    gate[70] = 0;
+
+    ProbabilityMaskInput input{};
+    input.probability = probability.data();
+    input.gate = gate.data();
+    input.enabledMask = {.low = ~uint64_t{0}, .high = ~uint64_t{0}};
+    input.length = 100;
+
+    const StepBitMask128 mask = resolveProbabilityMask(input);
+    StepBitMask128 expected = StepBitMask128::prefixMask(100);
+    expected.setBit(3, false);
+    expected.setBit(70, false);
+    TEST_ASSERT_TRUE(expected == mask);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_kernel_matches_reference_for_random_patterns);
+    RUN_TEST(test_kernel_handles_all_or_nothing_blocks);
+    return UNITY_END();
+}
@@ -0,0 +1,370 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/sequencer/NoteScheduler.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+
+using oc::note::sequencer::BasicNoteScheduler;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::NoteScheduler;
+using oc::note::sequencer::OverflowPolicy;
+using oc::note::sequencer::ScheduleStatus;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+
+namespace {
+
+class MockEventSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+    size_t acceptLimit = SIZE_MAX;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        if (events.size() >= acceptLimit) return false;
+        events.push_back(event);
+        return true;
+    }
+};
+
+class BatchSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+    std::vector<size_t> batchSizes;
+    size_t acceptLimit = SIZE_MAX;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        events.push_back(event);
+        return true;
+    }
+
+    size_t emitSequencerEvents(const SequencerEvent* batch, size_t count) override {
+        batchSizes.push_back(count);
+        size_t accepted = 0;
+        while (accepted < count && events.size() < acceptLimit) {
+            events.push_back(batch[accepted++]);
+        }
+        return accepted;
+    }
+};
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_events_are_released_in_tick_order() {
+    NoteScheduler scheduler;
+    MockEventSink sink;
+
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(30, 0, 63, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(10, 0, 61, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(20, 0, 62, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(0, 0, 60, 100));
+
+    TEST_ASSERT_TRUE(scheduler.processUntil(20, sink));
+    TEST_ASSERT_EQUAL(3, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[0].note);
+    TEST_ASSERT_EQUAL_UINT8(61, sink.events[1].note);
+    TEST_ASSERT_EQUAL_UINT8(62, sink.events[2].note);
+    TEST_ASSERT_EQUAL(1, static_cast<int>(scheduler.size()));
+
+    TEST_ASSERT_TRUE(scheduler.processUntil(30, sink));
+    TEST_ASSERT_EQUAL_UINT8(63, sink.events[3].note);
+    TEST_ASSERT_EQUAL(0, static_cast<int>(scheduler.size()));
+}
+
+void test_note_off_precedes_note_on_then_fifo() {
+    NoteScheduler scheduler;
+    MockEventSink sink;
+
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(6, 0, 70, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(6, 0, 71, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOff(6, 0, 60));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(6, 0, 72, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOff(6, 0, 61));
+
+    TEST_ASSERT_TRUE(scheduler.processUntil(6, sink));
+    TEST_ASSERT_EQUAL(5, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(SequencerEventType::NoteOff), static_cast<uint8_t>(sink.events[0].type));
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[0].note);
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(SequencerEventType::NoteOff), static_cast<uint8_t>(sink.events[1].type));
+    TEST_ASSERT_EQUAL_UINT8(61, sink.events[1].note);
+    TEST_ASSERT_EQUAL_UINT8(70, sink.events[2].note);
+    TEST_ASSERT_EQUAL_UINT8(71, sink.events[3].note);
+    TEST_ASSERT_EQUAL_UINT8(72, sink.events[4].note);
+}
+
+void test_rejected_event_stays_queued() {
+    NoteScheduler scheduler;
+    MockEventSink sink;
+    sink.acceptLimit = 1;
+
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(0, 0, 60, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOff(3, 0, 60));
+
+    TEST_ASSERT_FALSE(scheduler.processUntil(3, sink));
+    TEST_ASSERT_EQUAL(1, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL(1, static_cast<int>(scheduler.size()));
+
+    sink.acceptLimit = SIZE_MAX;
+    TEST_ASSERT_TRUE(scheduler.processUntil(3, sink));
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(SequencerEventType::NoteOff), static_cast<uint8_t>(sink.events[1].type));
+}
+
+void test_capacity_is_bounded() {
+    NoteScheduler scheduler;
+
+    for (size_t i = 0; i < NoteScheduler::MAX_EVENTS; ++i) {
+        TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(static_cast<uint32_t>(i), 0, 60, 100));
+    }
+    TEST_ASSERT_FALSE(scheduler.scheduleNoteOn(0, 0, 60, 100));
+
+    scheduler.clear();
+    TEST_ASSERT_EQUAL(0, static_cast<int>(scheduler.size()));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(0, 0, 60, 100));
+}
+
+void test_batch_drain_emits_spans_and_requeues_rejected_tail() {
+    NoteScheduler scheduler;
+    BatchSink sink;
+    sink.acceptLimit = 2;
+
+    for (uint8_t i = 0; i < 5; ++i) {
+        TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(4, 0, static_cast<uint8_t>(60 + i), 100));
+    }
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOff(4, 0, 59));
+
+    TEST_ASSERT_FALSE(scheduler.processBatchUntil(4, sink));
+    TEST_ASSERT_EQUAL(1, static_cast<int>(sink.batchSizes.size()));
+    TEST_ASSERT_EQUAL(6, static_cast<int>(sink.batchSizes[0]));
+    TEST_ASSERT_EQUAL(4, static_cast<int>(scheduler.size()));
+
+    sink.acceptLimit = SIZE_MAX;
+    TEST_ASSERT_TRUE(scheduler.processBatchUntil(4, sink));
+    TEST_ASSERT_EQUAL(6, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL_UINT8(59, sink.events[0].note);
+    for (uint8_t i = 0; i < 5; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(60 + i, sink.events[1 + i].note);
+    }
+}
+
+void test_entries_are_compact_and_ticks_are_relative() {
+    TEST_ASSERT_TRUE(sizeof(BasicNoteScheduler<32>) <= 32 * 8 + 16);
+
+    NoteScheduler scheduler;
+    MockEventSink sink;
+    const uint32_t base = 4'000'000'000u;
+
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(base + 1000, 0, 60, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(base + 60000, 0, 61, 100));
+    // Earlier than anything pending (negative nudge); forces a downward rebase.
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(base + 500, 0, 59, 100));
+    // Would span more than 16 bits of relative ticks.
+    TEST_ASSERT_FALSE(scheduler.scheduleNoteOn(base + 70000, 0, 62, 100));
+
+    TEST_ASSERT_TRUE(scheduler.processUntil(base + 1000, sink));
+    TEST_ASSERT_EQUAL(2, static_cast<int>(sink.events.size()));
+    // Once the early events drained, the later one fits again.
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(base + 70000, 0, 62, 100));
+    TEST_ASSERT_TRUE(scheduler.processUntil(UINT32_MAX, sink));
+
+    TEST_ASSERT_EQUAL(4, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL_UINT32(base + 500, sink.events[0].tick);
+    TEST_ASSERT_EQUAL_UINT32(base + 1000, sink.events[1].tick);
+    TEST_ASSERT_EQUAL_UINT32(base + 60000, sink.events[2].tick);
+    TEST_ASSERT_EQUAL_UINT32(base + 70000, sink.events[3].tick);
+    TEST_ASSERT_EQUAL_UINT8(62, sink.events[3].note);
+}
+
+void test_fifo_order_survives_sequence_renumbering() {
+    NoteScheduler scheduler;
+    MockEventSink sink;
+
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(100, 0, 1, 100));
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(100, 0, 2, 100));
+    for (uint32_t i = 0; i < 40000; ++i) {
+        TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(50, 0, 0, 1));
+        TEST_ASSERT_TRUE(scheduler.processUntil(50, sink));
+    }
+    TEST_ASSERT_TRUE(scheduler.scheduleNoteOn(100, 0, 3, 100));
+
+    sink.events.clear();
+    TEST_ASSERT_TRUE(scheduler.processUntil(100, sink));
+    TEST_ASSERT_EQUAL(3, static_cast<int>(sink.events.size()));
+    for (uint8_t i = 0; i < 3; ++i) {
+        TEST_ASSERT_EQUAL_UINT8(i + 1, sink.events[i].note);
+    }
+}
+
+template <OverflowPolicy Policy>
+void fillTwoNotes(BasicNoteScheduler<4, Policy>& scheduler) {
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Queued),
+                      static_cast<int>(scheduler.scheduleNote(0, 10, 0, 60, 100)));
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Queued),
+                      static_cast<int>(scheduler.scheduleNote(5, 15, 0, 61, 100)));
+}
+
+void test_overflow_clear_all_and_drop_newest() {
+    BasicNoteScheduler<4, OverflowPolicy::ClearAll> clearAll;
+    fillTwoNotes(clearAll);
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Rejected),
+                      static_cast<int>(clearAll.scheduleNote(8, 20, 0, 62, 100)));
+
+    BasicNoteScheduler<4, OverflowPolicy::DropNewest> dropNewest;
+    MockEventSink sink;
+    fillTwoNotes(dropNewest);
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Dropped),
+                      static_cast<int>(dropNewest.scheduleNote(8, 20, 0, 62, 100)));
+    TEST_ASSERT_TRUE(dropNewest.processUntil(100, sink));
+    TEST_ASSERT_EQUAL(4, static_cast<int>(sink.events.size()));
+    for (const auto& e : sink.events) {
+        TEST_ASSERT_TRUE(e.note != 62);
+    }
+}
+
+void test_overflow_steals_oldest_note_on_and_keeps_its_note_off() {
+    BasicNoteScheduler<4, OverflowPolicy::StealOldestNoteOn> scheduler;
+    MockEventSink sink;
+    fillTwoNotes(scheduler);
+
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Stolen),
+                      static_cast<int>(scheduler.scheduleNote(8, 20, 0, 62, 100)));
+    TEST_ASSERT_TRUE(scheduler.processUntil(100, sink));
+
+    TEST_ASSERT_EQUAL(4, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL_UINT8(62, sink.events[0].note);
+    TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::NoteOn), static_cast<int>(sink.events[0].type));
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[1].note);
+    TEST_ASSERT_EQUAL_UINT32(10, sink.events[1].tick);
+    TEST_ASSERT_EQUAL_UINT8(61, sink.events[2].note);
+    TEST_ASSERT_EQUAL_UINT32(15, sink.events[2].tick);
+    TEST_ASSERT_EQUAL_UINT8(62, sink.events[3].note);
+    TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::NoteOff), static_cast<int>(sink.events[3].type));
+}
+
+void test_overflow_merges_overlapping_same_pitch() {
+    BasicNoteScheduler<4, OverflowPolicy::Merge> scheduler;
+    MockEventSink sink;
+    fillTwoNotes(scheduler);
+
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Merged),
+                      static_cast<int>(scheduler.scheduleNote(6, 18, 0, 60, 90)));
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Dropped),
+                      static_cast<int>(scheduler.scheduleNote(30, 40, 0, 62, 90)));
+    TEST_ASSERT_TRUE(scheduler.processUntil(100, sink));
+
+    TEST_ASSERT_EQUAL(4, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL_UINT8(61, sink.events[2].note);
+    TEST_ASSERT_EQUAL_UINT32(15, sink.events[2].tick);
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[3].note);
+    TEST_ASSERT_EQUAL_UINT32(18, sink.events[3].tick);
+}
+
+void test_overflow_merge_skips_note_that_starts_later() {
+    BasicNoteScheduler<4, OverflowPolicy::Merge> scheduler;
+    MockEventSink sink;
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Queued),
+                      static_cast<int>(scheduler.scheduleNote(20, 30, 0, 60, 100)));
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Queued),
+                      static_cast<int>(scheduler.scheduleNote(5, 15, 0, 61, 100)));
+
+    // Note 60 is silent at tick 10, so there is nothing to extend.
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Dropped),
+                      static_cast<int>(scheduler.scheduleNote(10, 25, 0, 60, 90)));
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Merged),
+                      static_cast<int>(scheduler.scheduleNote(22, 35, 0, 60, 90)));
+    TEST_ASSERT_TRUE(scheduler.processUntil(100, sink));
+
+    TEST_ASSERT_EQUAL(4, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[2].note);
+    TEST_ASSERT_EQUAL_UINT32(20, sink.events[2].tick);
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[3].note);
+    TEST_ASSERT_EQUAL_UINT32(35, sink.events[3].tick);
+}
+
+void test_cancel_notes_withdraws_pending_tagged_notes_only() {
+    NoteScheduler scheduler;
+    MockEventSink sink;
+    TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Queued),
+                      static_cast<int>(scheduler.scheduleNote(0, 20, 0, 60, 100, 5)));
+    scheduler.scheduleNote(12, 30, 0, 60, 100, 5);
+    scheduler.scheduleNote(12, 18, 0, 62, 100, 6);
+    scheduler.scheduleNote(14, 16, 0, 64, 100);
+    TEST_ASSERT_TRUE(scheduler.processUntil(0, sink));
+    sink.events.clear();
+
+    TEST_ASSERT_EQUAL(0, static_cast<int>(scheduler.cancelNotes(0, 0)));
+    // The note sounding since tick 0 keeps its release at 20.
+    TEST_ASSERT_EQUAL(1, static_cast<int>(scheduler.cancelNotes(5, 0)));
+    TEST_ASSERT_EQUAL(5, static_cast<int>(scheduler.size()));
+
+    TEST_ASSERT_TRUE(scheduler.processUntil(100, sink));
+    TEST_ASSERT_EQUAL(5, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL_UINT8(62, sink.events[0].note);
+    TEST_ASSERT_EQUAL_UINT8(64, sink.events[1].note);
+    TEST_ASSERT_EQUAL_UINT8(60, sink.events[4].note);
+    TEST_ASSERT_EQUAL_UINT32(20, sink.events[4].tick);
+    TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::NoteOff), static_cast<int>(sink.events[4].type));
+}
+
+void test_cancel_notes_keeps_release_of_longer_earlier_note() {
+    NoteScheduler scheduler;
+    MockEventSink sink;
+    // The earlier note outlasts the later one of the same tag and pitch.
+    scheduler.scheduleNote(0, 40, 0, 60, 100, 5);
+    scheduler.scheduleNote(12, 20, 0, 60, 100, 5);
+    TEST_ASSERT_TRUE(scheduler.processUntil(0, sink));
+    sink.events.clear();
+
+    TEST_ASSERT_EQUAL(1, static_cast<int>(scheduler.cancelNotes(5, 0)));
+    TEST_ASSERT_TRUE(scheduler.processUntil(100, sink));
+    TEST_ASSERT_EQUAL(1, static_cast<int>(sink.events.size()));
+    TEST_ASSERT_EQUAL(static_cast<int>(SequencerEventType::NoteOff), static_cast<int>(sink.events[0].type));
+    TEST_ASSERT_EQUAL_UINT32(40, sink.events[0].tick);
+    TEST_ASSERT_EQUAL_UINT8(0, sink.events[0].velocity);
+}
+
+void test_cancel_notes_leaves_a_valid_heap_after_many_removals() {
+    NoteScheduler scheduler;
+    MockEventSink sink;
+    // 60 notes in scrambled tick order; every third belongs to tag 7.
+    for (uint32_t i = 0; i < 60; ++i) {
+        const uint32_t onTick = 10U + (i * 37U) % 60U;
+        const uint8_t tag = (i % 3U == 0U) ? 7U : 8U;
+        TEST_ASSERT_EQUAL(static_cast<int>(ScheduleStatus::Queued),
+                          static_cast<int>(scheduler.scheduleNote(onTick, onTick + 5U, 0,
+                                                                  static_cast<uint8_t>(i), 100, tag)));
+    }
+
+    TEST_ASSERT_EQUAL(20, static_cast<int>(scheduler.cancelNotes(7, 0)));
+    TEST_ASSERT_EQUAL(80, static_cast<int>(scheduler.size()));
+
+    TEST_ASSERT_TRUE(scheduler.processUntil(200, sink));
+    TEST_ASSERT_EQUAL(80, static_cast<int>(sink.events.size()));
+    for (size_t i = 0; i < sink.events.size(); ++i) {
+        TEST_ASSERT_TRUE(sink.events[i].note % 3U != 0U);
+        if (i > 0) TEST_ASSERT_TRUE(sink.events[i - 1U].tick <= sink.events[i].tick);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_events_are_released_in_tick_order);
+    RUN_TEST(test_note_off_precedes_note_on_then_fifo);
+    RUN_TEST(test_rejected_event_stays_queued);
+    RUN_TEST(test_capacity_is_bounded);
+    RUN_TEST(test_batch_drain_emits_spans_and_requeues_rejected_tail);
+    RUN_TEST(test_entries_are_compact_and_ticks_are_relative);
+    RUN_TEST(test_fifo_order_survives_sequence_renumbering);
+    RUN_TEST(test_overflow_clear_all_and_drop_newest);
+    RUN_TEST(test_overflow_steals_oldest_note_on_and_keeps_its_note_off);
+    RUN_TEST(test_overflow_merges_overlapping_same_pitch);
+    RUN_TEST(test_overflow_merge_skips_note_that_starts_later);
+    RUN_TEST(test_cancel_notes_withdraws_pending_tagged_notes_only);
+    RUN_TEST(test_cancel_notes_keeps_release_of_longer_earlier_note);
+    RUN_TEST(test_cancel_notes_leaves_a_valid_heap_after_many_removals);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/sequencer/SequencerConfig.hpp>
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+#include <oc/note/sequencer/StepSequencerState.hpp>
+#include <oc/note/sequencer/StepSequencerStateBridge.hpp>
+
+using oc::note::sequencer::BasicStepSequencerRuntimeState;
+using oc::note::sequencer::BasicStepSequencerState;
+using oc::note::sequencer::BasicStepSequencerStateBridge;
+using oc::note::sequencer::DrumLaneSequencerConfig;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerRuntimeState;
+using oc::note::sequencer::StepSequencerState;
+using oc::note::sequencer::StepSequencerStateBridge;
+
+namespace {
+
+class MockEventSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        events.push_back(event);
+        return true;
+    }
+};
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_push_coalesces_frame_edits_into_changed_steps() {
+    StepSequencerState ui;
+    StepSequencerRuntimeState runtime;
+    StepSequencerStateBridge bridge(ui);
+    runtime.dirtySteps = {};
+    const uint32_t generation = runtime.generation;
+
+    bridge.setNote(2, 70);
+    bridge.setNote(2, 72);
+    bridge.setGate(2, 500);
+    bridge.setVelocity(3, StepSequencerState::DEFAULT_VELOCITY);
+    ui.setEnabled(5, true);
+    ui.length.set(16);
+
+    TEST_ASSERT_TRUE(bridge.pushEdits(runtime));
+    TEST_ASSERT_EQUAL_UINT8(72, runtime.note[2]);
+    TEST_ASSERT_EQUAL_UINT16(StepSequencerState::MAX_GATE_PERCENT, runtime.gate[2]);
+    TEST_ASSERT_EQUAL_UINT8(16, runtime.length);
+    TEST_ASSERT_TRUE(runtime.enabledMask.test(5));
+    // Step 3 was touched but not changed.
+    TEST_ASSERT_TRUE(runtime.dirtySteps == StepBitMask128::fromLower64((1ULL << 2) | (1ULL << 5)));
+    TEST_ASSERT_EQUAL_UINT32(generation + 3U, runtime.generation);
+
+    TEST_ASSERT_FALSE(bridge.pushEdits(runtime));
+}
+
+void test_mark_all_steps_dirty_resyncs_bulk_changes() {
+    StepSequencerState ui;
+    StepSequencerRuntimeState runtime;
+    StepSequencerStateBridge bridge(ui);
+
+    for (uint8_t i = 0; i < StepSequencerState::MAX_STEPS; ++i) {
+        ui.probability[i] = 25;
+    }
+    ui.nudge[100] = -20;
+    bridge.markAllStepsDirty();
+
+    TEST_ASSERT_TRUE(bridge.pushEdits(runtime));
+    TEST_ASSERT_EQUAL_UINT8(25, runtime.probability[0]);
+    TEST_ASSERT_EQUAL_UINT8(25, runtime.probability[127]);
+    TEST_ASSERT_EQUAL_INT8(-20, runtime.nudge[100]);
+}
+
+void test_pull_playback_mirrors_engine_fields() {
+    StepSequencerState ui;
+    StepSequencerRuntimeState runtime;
+    StepSequencerStateBridge bridge(ui);
+    ui.length.set(4);
+    for (uint8_t i = 0; i < 4; ++i) {
+        ui.setEnabled(i, true);
+    }
+    bridge.setNote(1, 67);
+    bridge.pushEdits(runtime);
+
+    MockEventSink sink;
+    StepSequencerEngine eng(runtime, sink);
+    for (uint32_t tick = 0; tick <= 7; ++tick) {
+        eng.update(tick, true);
+    }
+    bridge.pullPlayback(runtime);
+
+    TEST_ASSERT_EQUAL_INT16(1, ui.playheadStep.get());
+    TEST_ASSERT_EQUAL_UINT32(runtime.probabilityCycleRevision, ui.probabilityCycleRevision.get());
+    TEST_ASSERT_TRUE(ui.probabilityCycleMask == runtime.probabilityCycleMask);
+
+    bool played = false;
+    for (const auto& e : sink.events) {
+        if (e.type == SequencerEventType::NoteOn && e.note == 67 && e.tick == 6) played = true;
+    }
+    TEST_ASSERT_TRUE(played);
+}
+
+void test_sixteen_step_bridge_pushes_into_sixteen_step_runtime() {
+    using Config = DrumLaneSequencerConfig;
+    BasicStepSequencerState<Config> ui;
+    BasicStepSequencerRuntimeState<Config> runtime;
+    BasicStepSequencerStateBridge<Config> bridge(ui);
+    runtime.dirtySteps = {};
+
+    bridge.setNote(15, 70);
+    bridge.setNote(16, 71);
+    ui.setEnabled(15, true);
+    ui.setEnabled(16, true);
+
+    TEST_ASSERT_TRUE(bridge.pushEdits(runtime));
+    TEST_ASSERT_EQUAL_UINT8(70, runtime.note[15]);
+    TEST_ASSERT_TRUE(runtime.enabledMask == Config::StepMask::fromLower64(1ULL << 15));
+    TEST_ASSERT_TRUE(runtime.dirtySteps == Config::StepMask::fromLower64(1ULL << 15));
+    TEST_ASSERT_TRUE(sizeof(ui) < sizeof(StepSequencerState) / 4U);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_push_coalesces_frame_edits_into_changed_steps);
+    RUN_TEST(test_mark_all_steps_dirty_resyncs_bulk_changes);
+    RUN_TEST(test_pull_playback_mirrors_engine_fields);
+    RUN_TEST(test_sixteen_step_bridge_pushes_into_sixteen_step_runtime);
+    return UNITY_END();
+}
@@ -0,0 +1,204 @@
+#include <unity.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerEngine.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+#include <oc/note/sequencer/StepSequencerState.hpp>
+#include <oc/note/sequencer/StepSequencerStateBridge.hpp>
+#include <oc/note/sequencer/StepSequencerStateExchange.hpp>
+
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::SequencerEventType;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerEngine;
+using oc::note::sequencer::StepSequencerPlayback;
+using oc::note::sequencer::StepSequencerRuntimeState;
+using oc::note::sequencer::StepSequencerState;
+using oc::note::sequencer::StepSequencerStateBridge;
+using oc::note::sequencer::StepSequencerStateExchange;
+
+namespace {
+
+class MockEventSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        events.push_back(event);
+        return true;
+    }
+};
+
+void fillPattern(StepSequencerRuntimeState& st) {
+    st.length = 4;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(4);
+    for (uint8_t i = 0; i < 4; ++i) {
+        st.note[i] = static_cast<uint8_t>(60 + i);
+        st.velocity[i] = 100;
+        st.gate[i] = 50;
+    }
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_pull_sees_only_published_batches() {
+    StepSequencerRuntimeState engineState;
+    fillPattern(engineState);
+    StepSequencerStateExchange exchange(engineState);
+    engineState.dirtySteps = {};
+
+    exchange.edit().setNote(3, 72);
+    exchange.edit().setStepEnabled(5, true);
+    TEST_ASSERT_FALSE(exchange.pullInto(engineState));
+    TEST_ASSERT_EQUAL_UINT8(63, engineState.note[3]);
+
+    exchange.publish();
+    TEST_ASSERT_TRUE(exchange.pullInto(engineState));
+    TEST_ASSERT_EQUAL_UINT8(72, engineState.note[3]);
+    TEST_ASSERT_TRUE(engineState.enabledMask.test(5));
+    TEST_ASSERT_TRUE(engineState.dirtySteps == StepBitMask128::fromLower64((1ULL << 3) | (1ULL << 5)));
+    TEST_ASSERT_FALSE(exchange.pullInto(engineState));
+
+    // The editor keeps working on top of what it published.
+    TEST_ASSERT_EQUAL_UINT8(72, exchange.edit().note[3]);
+    TEST_ASSERT_FALSE(exchange.edit().dirtySteps.any());
+}
+
+void test_skipped_snapshot_keeps_its_dirty_steps() {
+    StepSequencerRuntimeState engineState;
+    fillPattern(engineState);
+    StepSequencerStateExchange exchange(engineState);
+    engineState.dirtySteps = {};
+
+    exchange.edit().setGate(1, 120);
+    exchange.publish();
+    exchange.edit().setVelocity(2, 7);
+    exchange.publish();
+    exchange.edit().setNudge(0, -10);
+    exchange.publish();
+
+    TEST_ASSERT_TRUE(exchange.pullInto(engineState));
+    TEST_ASSERT_EQUAL_UINT16(120, engineState.gate[1]);
+    TEST_ASSERT_EQUAL_UINT8(7, engineState.velocity[2]);
+    TEST_ASSERT_EQUAL_INT8(-10, engineState.nudge[0]);
+    TEST_ASSERT_TRUE(engineState.dirtySteps == StepBitMask128::fromLower64(0x7ULL));
+}
+
+void test_engine_applies_published_edits_at_step_boundary() {
+    StepSequencerRuntimeState engineState;
+    fillPattern(engineState);
+    StepSequencerStateExchange exchange(engineState);
+    MockEventSink sink;
+    StepSequencerEngine eng(engineState, sink);
+    eng.setStateSource(&exchange);
+
+    for (uint32_t tick = 0; tick <= 8; ++tick) {
+        eng.update(tick, true);
+    }
+
+    // Step 3 is already queued; the batch lands at the step 2 boundary (tick 12).
+    exchange.edit().setNote(3, 72);
+    exchange.edit().setProbability(2, 0);
+    exchange.publish();
+
+    for (uint32_t tick = 9; tick <= 11; ++tick) {
+        eng.update(tick, true);
+    }
+    TEST_ASSERT_EQUAL_UINT8(63, engineState.note[3]);
+
+    sink.events.clear();
+    for (uint32_t tick = 12; tick <= 18; ++tick) {
+        eng.update(tick, true);
+    }
+    TEST_ASSERT_EQUAL_UINT8(72, engineState.note[3]);
+
+    bool sawEdited = false;
+    for (const auto& e : sink.events) {
+        if (e.type != SequencerEventType::NoteOn) continue;
+        TEST_ASSERT_FALSE(e.note == 62 || e.note == 63);
+        if (e.note == 72 && e.tick == 18) sawEdited = true;
+    }
+    TEST_ASSERT_TRUE(sawEdited);
+}
+
+void test_engine_publishes_playback_for_the_ui() {
+    StepSequencerRuntimeState engineState;
+    fillPattern(engineState);
+    StepSequencerStateExchange exchange(engineState);
+    MockEventSink sink;
+    StepSequencerEngine eng(engineState, sink);
+    eng.setStateSource(&exchange);
+
+    TEST_ASSERT_EQUAL_INT16(-1, exchange.playback().playheadStep);
+    for (uint32_t tick = 0; tick <= 13; ++tick) {
+        eng.update(tick, true);
+    }
+
+    StepSequencerState ui;
+    StepSequencerStateBridge bridge(ui);
+    bridge.pullPlayback(exchange.playback());
+    TEST_ASSERT_EQUAL_INT16(2, ui.playheadStep.get());
+    TEST_ASSERT_EQUAL_UINT32(engineState.probabilityCycleRevision, ui.probabilityCycleRevision.get());
+    TEST_ASSERT_TRUE(ui.probabilityCycleMask == engineState.probabilityCycleMask);
+
+    eng.update(14, false);
+    TEST_ASSERT_EQUAL_INT16(-1, exchange.playback().playheadStep);
+}
+
+void test_playback_reads_are_never_torn() {
+    StepSequencerRuntimeState engineState;
+    StepSequencerStateExchange exchange(engineState);
+    std::atomic<bool> done{false};
+
+    // Every field of a publish is derived from its revision, so a mixed read shows up.
+    std::thread engine([&] {
+        for (uint32_t revision = 1; revision <= 200000; ++revision) {
+            engineState.playheadStep = static_cast<int16_t>(revision % 128U);
+            engineState.probabilityCycleIndex = revision * 3U;
+            engineState.probabilityCycleMask.low = revision * 0x9E3779B97F4A7C15ull;
+            engineState.probabilityCycleMask.high = ~engineState.probabilityCycleMask.low;
+            engineState.probabilityCycleRevision = revision;
+            exchange.publishPlayback(engineState);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint32_t lastRevision = 0;
+    bool consistent = true;
+    while (!done.load(std::memory_order_acquire)) {
+        const StepSequencerPlayback playback = exchange.playback();
+        const uint32_t revision = playback.probabilityCycleRevision;
+        if (revision == 0) continue;
+        consistent = consistent && revision >= lastRevision
+                     && playback.playheadStep == static_cast<int16_t>(revision % 128U)
+                     && playback.probabilityCycleIndex == revision * 3U
+                     && playback.probabilityCycleMask.low == revision * 0x9E3779B97F4A7C15ull
+                     && playback.probabilityCycleMask.high == ~playback.probabilityCycleMask.low;
+        lastRevision = revision;
+    }
+    engine.join();
+
+    TEST_ASSERT_TRUE(consistent);
+    TEST_ASSERT_EQUAL_UINT32(200000, exchange.playback().probabilityCycleRevision);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pull_sees_only_published_batches);
+    RUN_TEST(test_skipped_snapshot_keeps_its_dirty_steps);
+    RUN_TEST(test_engine_applies_published_edits_at_step_boundary);
+    RUN_TEST(test_engine_publishes_playback_for_the_ui);
+    RUN_TEST(test_playback_reads_are_never_torn);
+    return UNITY_END();
+}
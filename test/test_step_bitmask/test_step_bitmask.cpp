@@ -0,0 +1,138 @@
+#include <unity.h>
+
+#include <cstdint>
+
+#include <oc/note/sequencer/StepBitMask.hpp>
+#include <oc/note/sequencer/StepBitMask128.hpp>
+
+using oc::note::sequencer::StepBitMask;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::fromStepBitMask128;
+using oc::note::sequencer::toStepBitMask128;
+
+namespace {
+
+uint64_t nextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+/// Drive `Mask` and `StepBitMask128` through the same operations and compare every query.
+template <uint8_t Steps>
+void checkMatchesWideMask() {
+    using Mask = StepBitMask<Steps>;
+    const StepBitMask128 limit = StepBitMask128::prefixMask(Steps);
+
+    uint64_t seed = 0x9E3779B97F4A7C15ull + Steps;
+    Mask a{};
+    StepBitMask128 wide{};
+    for (int round = 0; round < 2000; ++round) {
+        const uint64_t r = nextRandom(seed);
+        const uint8_t index = static_cast<uint8_t>(r % (Steps + 4U));
+        const Mask other = Mask::fromLower64(nextRandom(seed));
+        const StepBitMask128 otherWide = toStepBitMask128(other);
+
+        switch ((r >> 32) % 7) {
+            case 0: {
+                const bool enabled = ((r >> 40) & 1U) != 0;
+                a.setBit(index, enabled);
+                if (index < Steps) wide.setBit(index, enabled);
+                break;
+            }
+            case 1:
+                a.toggleBit(index);
+                if (index < Steps) wide.toggleBit(index);
+                break;
+            case 2: a |= other; wide |= otherWide; break;
+            case 3: a &= other; wide &= otherWide; break;
+            case 4: a ^= other; wide ^= otherWide; break;
+            case 5: a = ~a; wide = ~wide & limit; break;
+            default: a = Mask::prefixMask(index); wide = StepBitMask128::prefixMask(index) & limit; break;
+        }
+
+        TEST_ASSERT_TRUE(toStepBitMask128(a) == wide);
+        TEST_ASSERT_TRUE(fromStepBitMask128<Mask>(wide) == a);
+        TEST_ASSERT_EQUAL(wide.any(), a.any());
+        TEST_ASSERT_EQUAL_UINT8(wide.count(), a.count());
+        TEST_ASSERT_EQUAL_UINT8(wide.rank(index), a.rank(index));
+        TEST_ASSERT_EQUAL(wide.test(index), a.test(index));
+    }
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_mask_picks_smallest_word() {
+    TEST_ASSERT_EQUAL(4, static_cast<int>(sizeof(StepBitMask<16>)));
+    TEST_ASSERT_EQUAL(4, static_cast<int>(sizeof(StepBitMask<32>)));
+    TEST_ASSERT_EQUAL(8, static_cast<int>(sizeof(StepBitMask<48>)));
+    TEST_ASSERT_EQUAL(8, static_cast<int>(sizeof(StepBitMask<64>)));
+    TEST_ASSERT_EQUAL(16, static_cast<int>(sizeof(StepBitMask<128>)));
+}
+
+void test_word_masks_match_wide_mask() {
+    checkMatchesWideMask<16>();
+    checkMatchesWideMask<32>();
+    checkMatchesWideMask<48>();
+    checkMatchesWideMask<64>();
+}
+
+void test_word_masks_ignore_steps_past_capacity() {
+    StepBitMask<16> mask = ~StepBitMask<16>{};
+    TEST_ASSERT_EQUAL_UINT8(16, mask.count());
+    TEST_ASSERT_FALSE(mask.test(16));
+
+    mask.setBit(20);
+    mask.toggleBit(31);
+    TEST_ASSERT_EQUAL_UINT8(16, mask.count());
+    TEST_ASSERT_TRUE(StepBitMask<16>::fromLower64(0xFFFF0000u) == StepBitMask<16>{});
+    TEST_ASSERT_TRUE(StepBitMask<16>::prefixMask(128) == mask);
+}
+
+void test_find_next_set_and_rotate_match_bitwise_reference() {
+    uint64_t seed = 0xD1B54A32D192ED03ull;
+    for (int round = 0; round < 200; ++round) {
+        StepBitMask128 mask{};
+        mask.low = nextRandom(seed) & nextRandom(seed);
+        mask.high = nextRandom(seed) & nextRandom(seed);
+        const StepBitMask<64> word = fromStepBitMask128<StepBitMask<64>>(mask);
+        const uint8_t width = static_cast<uint8_t>(1 + nextRandom(seed) % 128U);
+        const uint8_t amount = static_cast<uint8_t>(nextRandom(seed) % 200U);
+
+        for (uint8_t from = 0; from <= 130; ++from) {
+            uint8_t expected = StepBitMask128::BITS;
+            for (uint8_t i = from; i < 128; ++i) {
+                if (mask.test(i)) {
+                    expected = i;
+                    break;
+                }
+            }
+            TEST_ASSERT_EQUAL_UINT8(expected, mask.findNextSet(from));
+            TEST_ASSERT_EQUAL_UINT8((expected < 64) ? expected : 64, word.findNextSet(from));
+        }
+
+        StepBitMask128 rotated{};
+        for (uint8_t i = 0; i < width; ++i) {
+            if (mask.test(i)) rotated.setBit(static_cast<uint8_t>((i + amount) % width));
+        }
+        TEST_ASSERT_TRUE(mask.rotateLeft(amount, width) == rotated);
+        TEST_ASSERT_TRUE(rotated.rotateRight(amount, width) == (mask & StepBitMask128::prefixMask(width)));
+        if (width <= 64) {
+            TEST_ASSERT_TRUE(toStepBitMask128(word.rotateLeft(amount, width)) == rotated);
+        }
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_mask_picks_smallest_word);
+    RUN_TEST(test_word_masks_match_wide_mask);
+    RUN_TEST(test_word_masks_ignore_steps_past_capacity);
+    RUN_TEST(test_find_next_set_and_rotate_match_bitwise_reference);
+    return UNITY_END();
+}
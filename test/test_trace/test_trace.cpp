@@ -0,0 +1,163 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <oc/note/sequencer/SequencerEvent.hpp>
+#include <oc/note/sequencer/StepSequencerRuntimeState.hpp>
+#include <oc/note/sequencer/StepSequencerTrace.hpp>
+#include <oc/note/sequencer/StepSequencerTraceReplay.hpp>
+
+using oc::note::sequencer::BasicSequencerTrace;
+using oc::note::sequencer::ISequencerEventSink;
+using oc::note::sequencer::SequencerEvent;
+using oc::note::sequencer::StepBitMask128;
+using oc::note::sequencer::StepSequencerRuntimeState;
+using oc::note::sequencer::TracedInternalClock;
+using oc::note::sequencer::TracedStepSequencerEngine;
+using oc::note::sequencer::TraceRecord;
+using oc::note::sequencer::TraceRecordKind;
+using oc::note::sequencer::readTraceFile;
+using oc::note::sequencer::replayTrace;
+using oc::note::sequencer::traceFileSize;
+using oc::note::sequencer::writeTraceFile;
+
+namespace {
+
+/// Refuses every 5th event, so the trace has to carry sink back-pressure.
+class FlakyEventSink final : public ISequencerEventSink {
+public:
+    std::vector<SequencerEvent> events;
+    uint32_t calls = 0;
+
+    bool emitSequencerEvent(const SequencerEvent& event) override {
+        if (++calls % 5U == 0) return false;
+        events.push_back(event);
+        return true;
+    }
+};
+
+// Room for a couple of seconds of 1 ms clock and engine updates.
+BasicSequencerTrace<8192> trace;
+
+/// Clock-driven session with edits between updates: probability, a chord and a CC lock.
+template <typename Trace>
+size_t recordSession(Trace& into, uint32_t milliseconds) {
+    StepSequencerRuntimeState st;
+    st.length = 8;
+    st.stepsPerBeat = 4;
+    st.enabledMask = StepBitMask128::prefixMask(8);
+    st.probability[3] = 40;
+
+    FlakyEventSink sink;
+    TracedStepSequencerEngine<ISequencerEventSink, Trace> eng(st, sink, into);
+    TracedInternalClock<Trace> clk(into);
+    clk.setBpm(133.0f);
+    clk.setTicksPerQuarter(96);
+    eng.setTicksPerQuarter(96);
+    eng.setNextRunSeed(7);
+    clk.setPlaying(true);
+
+    const uint8_t chordNotes[2] = {55, 58};
+    const uint8_t chordVelocities[2] = {90, 80};
+    for (uint32_t ms = 0; ms < milliseconds; ++ms) {
+        if (ms == 300) st.setNote(2, 67);
+        if (ms == 700) st.setChord(4, chordNotes, chordVelocities, 2);
+        if (ms == 900) st.setParameterLock(6, 74, 20);
+        if (ms == 1200) st.length = 5;
+        clk.update(ms);
+        eng.update(clk.tick(), clk.isPlaying());
+    }
+    eng.update(clk.tick(), false);
+    return sink.events.size();
+}
+
+}  // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_recorded_session_replays_bit_exactly() {
+    const size_t delivered = recordSession(trace, 2000);
+    TEST_ASSERT_TRUE(trace.complete());
+    TEST_ASSERT_TRUE(delivered > 20);
+
+    size_t patches = 0;
+    size_t refused = 0;
+    for (size_t i = 0; i < trace.size(); ++i) {
+        const TraceRecord& record = trace.records()[i];
+        if (record.kind == TraceRecordKind::StatePatch) ++patches;
+        if (record.kind == TraceRecordKind::Event && record.arg == 0) ++refused;
+    }
+    TEST_ASSERT_TRUE(patches > 0);
+    TEST_ASSERT_TRUE(refused > 0);
+
+    const auto result = replayTrace(trace);
+    TEST_ASSERT_TRUE(result.matched);
+    TEST_ASSERT_EQUAL_UINT32(trace.size(), result.firstMismatch);
+    TEST_ASSERT_EQUAL_UINT32(delivered + refused, result.eventCount);
+    TEST_ASSERT_EQUAL_UINT32(2001, result.updateCount);
+}
+
+void test_replay_reports_first_divergence() {
+    recordSession(trace, 1000);
+    std::vector<TraceRecord> records(trace.records(), trace.records() + trace.size());
+
+    size_t tampered = records.size();
+    for (size_t i = records.size() / 2; i < records.size(); ++i) {
+        if (records[i].kind != TraceRecordKind::Event) continue;
+        records[i].data[2] ^= 1U;
+        tampered = i;
+        break;
+    }
+    TEST_ASSERT_TRUE(tampered < records.size());
+    auto result = replayTrace(trace.initialState(), records.data(), records.size());
+    TEST_ASSERT_FALSE(result.matched);
+    TEST_ASSERT_EQUAL_UINT32(tampered, result.firstMismatch);
+
+    // A clock tick that no longer matches is caught as well.
+    records.assign(trace.records(), trace.records() + trace.size());
+    for (auto& record : records) {
+        if (record.kind == TraceRecordKind::ClockTick && record.tick > 100) {
+            record.tick += 1;
+            break;
+        }
+    }
+    result = replayTrace(trace.initialState(), records.data(), records.size());
+    TEST_ASSERT_FALSE(result.matched);
+
+    // A full buffer stops recording instead of overwriting the snapshot's start.
+    static BasicSequencerTrace<64> small;
+    recordSession(small, 1000);
+    TEST_ASSERT_EQUAL_UINT32(64, small.size());
+    TEST_ASSERT_FALSE(small.complete());
+}
+
+void test_trace_file_round_trip() {
+    recordSession(trace, 500);
+    static std::vector<uint8_t> file;
+    file.assign(traceFileSize(trace.size()), 0);
+    TEST_ASSERT_EQUAL_UINT32(file.size(), writeTraceFile(trace, file.data(), file.size()));
+    TEST_ASSERT_EQUAL_UINT32(0, writeTraceFile(trace, file.data(), file.size() - 1U));
+
+    StepSequencerRuntimeState initial;
+    std::vector<TraceRecord> records(trace.CAPACITY);
+    size_t count = 0;
+    TEST_ASSERT_TRUE(readTraceFile(file.data(), file.size(), initial, records.data(), records.size(), count));
+    TEST_ASSERT_EQUAL_UINT32(trace.size(), count);
+    TEST_ASSERT_TRUE(replayTrace(initial, records.data(), count).matched);
+
+    const size_t capacity = records.size();
+    TEST_ASSERT_FALSE(readTraceFile(file.data(), file.size() - 1U, initial, records.data(), capacity, count));
+    file[0] = 'X';
+    TEST_ASSERT_FALSE(readTraceFile(file.data(), file.size(), initial, records.data(), capacity, count));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_recorded_session_replays_bit_exactly);
+    RUN_TEST(test_replay_reports_first_divergence);
+    RUN_TEST(test_trace_file_round_trip);
+    return UNITY_END();
+}